@@ -1,30 +1,299 @@
 #include "../lib/ArgParser.h"
+#include "../lib/StreamParser.h"
 
-#include <cassert>
-#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <fstream>
 #include <iostream>
-#include <iterator>
-#include <numeric>
+#include <limits>
 #include <string>
-#include <sstream>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 struct Options {
     bool sum = false;
     bool mult = false;
+    bool stats = false;
+    int32_t threads = 1;
+    std::string input;
 };
 
+struct Reduction {
+    int64_t sum = 0;
+    int64_t product = 1;
+    bool sum_fits = true;
+    bool product_fits = true;
+    bool zero_seen = false;
+    size_t count = 0;
+};
+
+const size_t kLanesCount = 8;
+const size_t kParallelThreshold = 1 << 20;
+const size_t kBatchSize = kParallelThreshold;
+
+bool CheckedAdd(int64_t lhs, int64_t rhs, int64_t& result) {
+    if ((rhs > 0 && lhs > std::numeric_limits<int64_t>::max() - rhs)
+        || (rhs < 0 && lhs < std::numeric_limits<int64_t>::min() - rhs)) {
+        return false;
+    }
+
+    result = lhs + rhs;
+
+    return true;
+}
+
+bool CheckedMultiply(int64_t lhs, int64_t rhs, int64_t& result) {
+    if (lhs == 0 || rhs == 0) {
+        result = 0;
+
+        return true;
+    }
+
+    const int64_t max = std::numeric_limits<int64_t>::max();
+    const int64_t min = std::numeric_limits<int64_t>::min();
+
+    if ((lhs > 0 && rhs > 0 && lhs > max / rhs)
+        || (lhs < 0 && rhs < 0 && lhs < max / rhs)
+        || (lhs > 0 && rhs < 0 && rhs < min / lhs)
+        || (lhs < 0 && rhs > 0 && lhs < min / rhs)) {
+        return false;
+    }
+
+    result = lhs * rhs;
+
+    return true;
+}
+
+int64_t SumLiterals(const int32_t* values, size_t count) {
+    int64_t lanes[kLanesCount] = {};
+    size_t i = 0;
+
+    for (; i + kLanesCount <= count; i += kLanesCount) {
+        for (size_t lane = 0; lane < kLanesCount; ++lane) {
+            lanes[lane] += values[i + lane];
+        }
+    }
+
+    int64_t result = 0;
+
+    for (; i < count; ++i) {
+        result += values[i];
+    }
+
+    for (size_t lane = 0; lane < kLanesCount; ++lane) {
+        result += lanes[lane];
+    }
+
+    return result;
+}
+
+class ThreadsJoiner {
+public:
+    explicit ThreadsJoiner(std::vector<std::thread>& threads)
+        : threads_(threads)
+    {}
+
+    ~ThreadsJoiner() {
+        for (auto& thread: threads_) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+private:
+    std::vector<std::thread>& threads_;
+};
+
+int64_t SumLiteralsParallel(const int32_t* values, size_t count, size_t threads_count) {
+    size_t hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    threads_count = std::min({threads_count, hardware_threads, count});
+
+    std::vector<int64_t> partial(threads_count, 0);
+    std::vector<std::thread> threads;
+    size_t chunk = (count + threads_count - 1) / threads_count;
+
+    {
+        ThreadsJoiner joiner(threads);
+        threads.reserve(threads_count);
+
+        for (size_t i = 0; i < threads_count; ++i) {
+            size_t begin = std::min(count, i * chunk);
+            size_t end = std::min(count, begin + chunk);
+
+            try {
+                threads.emplace_back([&partial, values, begin, end, i]() {
+                    partial[i] = SumLiterals(values + begin, end - begin);
+                });
+            } catch (const std::system_error&) {
+                partial[i] = SumLiterals(values + begin, end - begin);
+            }
+        }
+    }
+
+    int64_t result = 0;
+
+    for (size_t i = 0; i < threads_count; ++i) {
+        result += partial[i];
+    }
+
+    return result;
+}
+
+bool SumRange(const ArgumentParser::IntSegment& segment, int64_t& result) {
+    int64_t count = static_cast<int64_t>(segment.count);
+    int64_t bounds = 2 * segment.start + segment.step * (count - 1);
+
+    if (count % 2 == 0) {
+        return CheckedMultiply(count / 2, bounds, result);
+    }
+
+    return CheckedMultiply(count, bounds / 2, result);
+}
+
+bool Sum(const ArgumentParser::IntValues& values, size_t threads_count, int64_t& result) {
+    result = 0;
+
+    for (const auto& segment: values.GetSegments()) {
+        int64_t segment_sum = 0;
+
+        if (!segment.literal) {
+            if (!SumRange(segment, segment_sum)) {
+                return false;
+            }
+        } else if (threads_count > 1 && segment.count >= kParallelThreshold) {
+            segment_sum = SumLiteralsParallel(values.GetSegmentLiterals(segment), segment.count, threads_count);
+        } else {
+            segment_sum = SumLiterals(values.GetSegmentLiterals(segment), segment.count);
+        }
+
+        if (!CheckedAdd(result, segment_sum, result)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ContainsZero(const ArgumentParser::IntValues& values) {
+    for (const auto& segment: values.GetSegments()) {
+        if (segment.literal) {
+            const int32_t* literals = values.GetSegmentLiterals(segment);
+
+            if (std::find(literals, literals + segment.count, 0) != literals + segment.count) {
+                return true;
+            }
+        } else {
+            int64_t last = segment.start + segment.step * static_cast<int64_t>(segment.count - 1);
+
+            if (std::min(segment.start, last) <= 0 && std::max(segment.start, last) >= 0 && segment.start % segment.step == 0) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool Multiply(const ArgumentParser::IntValues& values, int64_t& result) {
+    for (int32_t value: values) {
+        if (!CheckedMultiply(result, value, result)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Fold(const ArgumentParser::IntValues& values, size_t threads_count, Reduction& reduction) {
+    int64_t batch_sum = 0;
+
+    reduction.count += values.Size();
+
+    if (reduction.sum_fits) {
+        reduction.sum_fits = Sum(values, threads_count, batch_sum) && CheckedAdd(reduction.sum, batch_sum, reduction.sum);
+    }
+
+    if (!reduction.zero_seen && ContainsZero(values)) {
+        reduction.zero_seen = true;
+    }
+
+    if (!reduction.zero_seen && reduction.product_fits) {
+        reduction.product_fits = Multiply(values, reduction.product);
+    }
+}
+
+bool ParseInput(ArgumentParser::ArgParser& parser, int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i][0] == '-') {
+            parser.ParseToken(argv[i]);
+        }
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i][0] != '-') {
+            parser.ParseToken(argv[i]);
+        }
+    }
+
+    if (parser.GetStringValue("input").empty()) {
+        return parser.FinishParse();
+    }
+
+    ArgumentParser::StreamParser stream(parser);
+
+    if (parser.GetStringValue("input") == "-") {
+        std::ios::sync_with_stdio(false);
+        stream.Feed(std::cin);
+    } else {
+        std::ifstream file(parser.GetStringValue("input"), std::ios::binary);
+
+        if (!file) {
+            throw std::runtime_error("Cannot open " + parser.GetStringValue("input"));
+        }
+
+        stream.Feed(file);
+    }
+
+    return stream.Finish();
+}
+
 int main(int argc, char** argv) {
     Options opt;
-    std::vector<int> values;
+    Reduction reduction;
 
     ArgumentParser::ArgParser parser("Program");
-    parser.AddIntArgument("N").MultiValue(1).Positional().StoreValues(values);
-    parser.AddFlag("sum", "add args").StoreValue(opt.sum);
-    parser.AddFlag("mult", "multiply args").StoreValue(opt.mult);
+    parser.AddIntArgument('j', "threads", "threads for sum").Default(1);
+    ArgumentParser::OptionHandle<int32_t> threads = parser.GetHandle<int32_t>("threads");
+
+    parser.AddIntArgument("N").MultiValue(1).Positional().Sink([&threads, &reduction](const ArgumentParser::IntValues& values) {
+        Fold(values, static_cast<size_t>(std::max(threads.Get(), 1)), reduction);
+    }, kBatchSize);
+    parser.AddFlag("sum", "add args");
+    parser.AddFlag("mult", "multiply args");
+    parser.AddStringArgument('i', "input", "read more args from file, - for stdin").Default("");
+    parser.AddFlag("stats", "print throughput to stderr");
     parser.AddHelp('h', "help", "Program accumulate arguments");
+    parser.StoreFields(
+        opt,
+        ArgumentParser::Field("sum", &Options::sum),
+        ArgumentParser::Field("mult", &Options::mult),
+        ArgumentParser::Field("stats", &Options::stats),
+        ArgumentParser::Field("threads", &Options::threads),
+        ArgumentParser::Field("input", &Options::input)
+    );
+
+    auto parse_start = std::chrono::steady_clock::now();
 
-    if (!parser.Parse(argc, argv)) {
-        std::cout << "Wrong argument" << std::endl;
+    try {
+        if (!ParseInput(parser, argc, argv)) {
+            std::cout << "Wrong argument" << std::endl;
+            std::cout << parser.HelpDescription() << std::endl;
+            return 1;
+        }
+    } catch (const std::exception& error) {
+        std::cout << "Wrong argument: " << error.what() << std::endl;
         std::cout << parser.HelpDescription() << std::endl;
         return 1;
     }
@@ -34,15 +303,36 @@ int main(int argc, char** argv) {
         return 0;
     }
 
+    auto parse_end = std::chrono::steady_clock::now();
+    int64_t result = 0;
+    bool fits = true;
+
     if (opt.sum) {
-        std::cout << "Result: " << std::accumulate(values.begin(), values.end(), 0) << std::endl;
+        result = reduction.sum;
+        fits = reduction.sum_fits;
     } else if (opt.mult) {
-        std::cout << "Result: " << std::accumulate(values.begin(), values.end(), 1, std::multiplies<int>()) << std::endl;
+        result = (reduction.zero_seen ? 0 : reduction.product);
+        fits = reduction.zero_seen || reduction.product_fits;
     } else {
         std::cout << "No option was chosen" << std::endl;
         std::cout << parser.HelpDescription();
         return 1;
     }
 
-    return 0;
+    if (fits) {
+        std::cout << "Result: " << result << std::endl;
+    } else {
+        std::cout << "Result does not fit into 64-bit integer" << std::endl;
+    }
+
+    if (opt.stats) {
+        std::chrono::duration<double> parse_time = parse_end - parse_start;
+        double total_time = std::max(parse_time.count(), 1e-9);
+
+        std::cerr << "Values: " << reduction.count << "\n"
+                  << "Parse and reduce: " << parse_time.count() << " s\n"
+                  << "Throughput: " << static_cast<double>(reduction.count) / total_time << " values/s" << std::endl;
+    }
+
+    return fits ? 0 : 1;
 }
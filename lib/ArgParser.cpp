@@ -1,7 +1,31 @@
 #include "ArgParser.h"
+#include "Registry.h"
 
+#include <algorithm>
 #include <cassert>
+#include <charconv>
+#include <cstring>
 #include <stdexcept>
+#include <string_view>
+
+namespace {
+    int32_t ParseInt(std::string_view value, const std::string& full_name) {
+        std::string_view digits = value;
+
+        if (digits.size() > 1 && digits[0] == '+' && digits[1] != '-') {
+            digits.remove_prefix(1);
+        }
+
+        int32_t result = 0;
+        auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), result);
+
+        if (error != std::errc() || end != digits.data() + digits.size()) {
+            throw std::runtime_error("Argument " + full_name + " expects an integer, got " + std::string(value) + ".");
+        }
+
+        return result;
+    }
+}
 
 ArgumentParser::Argument::Argument() {}
 
@@ -10,12 +34,18 @@ ArgumentParser::Argument::Argument(const ArgumentType& type, char short_name, co
     , short_name_(short_name)
     , full_name_(full_name)
     , description_(description)
+    , default_in_use_(false)
     , storage_awaken_(false)
     , storage_(nullptr)
     , multi_value_(false)
     , min_args_count_(0)
     , multi_storage_(nullptr)
-    , takes_positional_(false)
+    , positional_arity_(PositionalArity::kNotPositional)
+    , positional_count_(0)
+    , duplicate_policy_(DuplicatePolicy::kKeepLast)
+    , delimiter_('\0')
+    , sink_batch_size_(0)
+    , sink_consumed_(0)
 {}
 
 ArgumentParser::Argument::Argument(const ArgumentType& type, const std::string& full_name, const std::string& description)
@@ -23,12 +53,18 @@ ArgumentParser::Argument::Argument(const ArgumentType& type, const std::string&
     , short_name_('?')
     , full_name_(full_name)
     , description_(description)
+    , default_in_use_(false)
     , storage_awaken_(false)
     , storage_(nullptr)
     , multi_value_(false)
     , min_args_count_(0)
     , multi_storage_(nullptr)
-    , takes_positional_(false)
+    , positional_arity_(PositionalArity::kNotPositional)
+    , positional_count_(0)
+    , duplicate_policy_(DuplicatePolicy::kKeepLast)
+    , delimiter_('\0')
+    , sink_batch_size_(0)
+    , sink_consumed_(0)
 {}
 
 char ArgumentParser::Argument::GetShortName() const {
@@ -47,7 +83,15 @@ ArgumentParser::ArgumentType ArgumentParser::Argument::GetType() const {
     return type_;
 }
 
-std::string ArgumentParser::Argument::GetStringValue(size_t index) const {
+ArgumentParser::PositionalArity ArgumentParser::Argument::GetPositionalArity() const {
+    return positional_arity_;
+}
+
+size_t ArgumentParser::Argument::GetPositionalCount() const {
+    return positional_count_;
+}
+
+const std::string& ArgumentParser::Argument::GetStringValue(size_t index) const {
     if (type_ != ArgumentType::kString) {
         throw std::runtime_error("Argument " + full_name_ + " does not contain string type.");
     }
@@ -60,7 +104,15 @@ int32_t ArgumentParser::Argument::GetIntValue(size_t index) const {
         throw std::runtime_error("Argument " + full_name_ + " does not contain integer type.");
     }
 
-    return std::stoi(values_[index]);
+    return int_values_[index];
+}
+
+const ArgumentParser::IntValues& ArgumentParser::Argument::GetIntValues() const {
+    if (type_ != ArgumentType::kInteger) {
+        throw std::runtime_error("Argument " + full_name_ + " does not contain integer type.");
+    }
+
+    return int_values_;
 }
 
 bool ArgumentParser::Argument::GetFlag() const {
@@ -75,31 +127,188 @@ bool ArgumentParser::Argument::GetFlag() const {
     return (values_[0] == "1" ? true : false);
 }
 
+size_t ArgumentParser::Argument::GetValuesCount() const {
+    if (type_ == ArgumentType::kInteger) {
+        return int_values_.Size();
+    }
+
+    if (type_ == ArgumentType::kMap) {
+        return map_values_.Size();
+    }
+
+    return values_.size();
+}
+
+size_t ArgumentParser::Argument::GetParsedValuesCount() const {
+    return sink_consumed_ + GetValuesCount();
+}
+
+const ArgumentParser::FlatStringMap& ArgumentParser::Argument::GetMap() const {
+    if (type_ != ArgumentType::kMap) {
+        throw std::runtime_error("Argument " + full_name_ + " does not contain map type.");
+    }
+
+    return map_values_;
+}
+
+std::string_view ArgumentParser::Argument::GetMapValue(std::string_view key) const {
+    const std::string_view* value = GetMap().Find(key);
+
+    if (value == nullptr) {
+        throw std::runtime_error("Argument " + full_name_ + " has no key " + std::string(key) + ".");
+    }
+
+    return *value;
+}
+
 bool ArgumentParser::Argument::Check() const {
-    return values_.size() > min_args_count_;
+    if (positional_arity_ == PositionalArity::kFixedPositional && GetParsedValuesCount() < positional_count_) {
+        return false;
+    }
+
+    if (positional_arity_ == PositionalArity::kOptionalPositional && GetParsedValuesCount() == 0) {
+        return true;
+    }
+
+    if (type_ == ArgumentType::kMap) {
+        return GetParsedValuesCount() >= min_args_count_;
+    }
+
+    return GetParsedValuesCount() > min_args_count_;
 }
 
-void ArgumentParser::Argument::AddValue(const std::string& value) {
+void ArgumentParser::Argument::AddValue(const std::string& value, size_t max_values) {
+    DropDefault();
+
     if (type_ == ArgumentType::kFlag && values_.size() == 1) {
         values_[0] = value;
 
         return;
     }
 
-    values_.emplace_back(value);
+    AddDelimited(value, max_values);
+}
+
+void ArgumentParser::Argument::DropDefault() {
+    if (!default_in_use_) {
+        return;
+    }
+
+    default_in_use_ = false;
+    values_.clear();
+    int_values_.Clear();
+}
+
+void ArgumentParser::Argument::AddDelimited(std::string_view value, size_t max_values) {
+    if (delimiter_ == '\0') {
+        AddToken(value);
+
+        return;
+    }
+
+    const char* begin = value.data();
+    const char* end = begin + value.size();
+
+    while (true) {
+        const char* found = static_cast<const char*>(std::memchr(begin, delimiter_, end - begin));
+
+        if (found == nullptr) {
+            AddToken(std::string_view(begin, end - begin));
+
+            return;
+        }
+
+        if (!multi_value_ && type_ != ArgumentType::kMap) {
+            throw std::runtime_error("Argument " + full_name_ + " does not accept several values.");
+        }
+
+        AddToken(std::string_view(begin, found - begin));
+        begin = found + 1;
+
+        if (GetParsedValuesCount() > max_values) {
+            throw std::runtime_error("Argument " + full_name_ + " has more than " + std::to_string(max_values) + " values.");
+        }
+    }
+}
+
+void ArgumentParser::Argument::AddToken(std::string_view token) {
+    if (type_ == ArgumentType::kInteger) {
+        AddIntToken(token);
+    } else if (type_ == ArgumentType::kMap) {
+        AddMapToken(token);
+    } else {
+        values_.emplace_back(token);
+    }
+}
+
+void ArgumentParser::Argument::AddIntToken(std::string_view token) {
+    size_t dots = token.find("..");
+
+    if (dots == std::string_view::npos) {
+        int_values_.Add(ParseInt(token, full_name_));
+
+        if (sink_ && int_values_.Size() >= sink_batch_size_) {
+            FlushSink();
+        }
+
+        return;
+    }
+
+    if (!multi_value_) {
+        throw std::runtime_error("Argument " + full_name_ + " does not accept ranges.");
+    }
+
+    std::string_view bounds = token.substr(dots + 2);
+    size_t colon = bounds.find(':');
+
+    int64_t start = ParseInt(token.substr(0, dots), full_name_);
+    int64_t stop = ParseInt(bounds.substr(0, colon), full_name_);
+    int64_t step = (stop >= start ? 1 : -1);
+
+    if (colon != std::string_view::npos) {
+        step = ParseInt(bounds.substr(colon + 1), full_name_);
+    }
+
+    if (step == 0 || (stop - start) * step < 0) {
+        throw std::runtime_error("Range " + std::string(token) + " of argument " + full_name_ + " is empty.");
+    }
+
+    int_values_.AddRange(static_cast<int32_t>(start), static_cast<int32_t>(step), static_cast<size_t>((stop - start) / step + 1));
+
+    if (sink_ && int_values_.Size() >= sink_batch_size_) {
+        FlushSink();
+    }
+}
+
+void ArgumentParser::Argument::AddMapToken(std::string_view token) {
+    std::string_view pair = map_values_.Store(token);
+    const char* equal_sign = static_cast<const char*>(std::memchr(pair.data(), '=', pair.size()));
+
+    if (equal_sign == nullptr) {
+        throw std::runtime_error("Argument " + full_name_ + " expects key=value, got " + std::string(token) + ".");
+    }
+
+    size_t key_size = equal_sign - pair.data();
+
+    if (!map_values_.Insert(pair.substr(0, key_size), pair.substr(key_size + 1), duplicate_policy_)) {
+        throw std::runtime_error("Argument " + full_name_ + " got duplicate key " + std::string(pair.substr(0, key_size)) + ".");
+    }
 }
 
 ArgumentParser::Argument& ArgumentParser::Argument::Default(const std::variant<int32_t, std::string, bool>& default_value) {
     if (type_ == ArgumentType::kInteger) {
-        std::string temporary_value = std::to_string(std::get<int32_t>(default_value));
+        int32_t value = std::get<int32_t>(default_value);
 
-        values_ = {temporary_value};
-        default_value_ = temporary_value;
+        int_values_.Clear();
+        int_values_.Add(value);
+        default_value_ = std::to_string(value);
     } else if (type_ == ArgumentType::kString) {
         std::string temporary_value = std::get<std::string>(default_value);
 
         values_ = {temporary_value};
         default_value_ = temporary_value;
+    } else if (type_ == ArgumentType::kMap) {
+        throw std::runtime_error("Map argument " + full_name_ + " cannot have a default value.");
     } else {
         assert(type_ == ArgumentType::kFlag);
         
@@ -114,18 +323,86 @@ ArgumentParser::Argument& ArgumentParser::Argument::Default(const std::variant<i
         }
     }
 
+    default_in_use_ = true;
+
     return *this;
 }
 
 ArgumentParser::Argument& ArgumentParser::Argument::MultiValue(size_t min_args_count) {
+    if (!std::holds_alternative<std::nullptr_t>(storage_)) {
+        throw std::runtime_error("Argument " + full_name_ + " is stored into a single variable and cannot take several values.");
+    }
+
     multi_value_ = true;
     min_args_count_ = min_args_count;
 
     return *this;
 }
 
+ArgumentParser::Argument& ArgumentParser::Argument::Delimiter(char delimiter) {
+    if (type_ == ArgumentType::kFlag) {
+        throw std::runtime_error("Flag " + full_name_ + " cannot have delimited values.");
+    }
+
+    delimiter_ = delimiter;
+
+    return *this;
+}
+
+ArgumentParser::Argument& ArgumentParser::Argument::DuplicateKeys(DuplicatePolicy policy) {
+    if (type_ != ArgumentType::kMap) {
+        throw std::runtime_error("Argument " + full_name_ + " is not a map.");
+    }
+
+    duplicate_policy_ = policy;
+
+    return *this;
+}
+
 ArgumentParser::Argument& ArgumentParser::Argument::Positional() {
-    takes_positional_ = true;
+    positional_arity_ = PositionalArity::kRestPositional;
+    positional_count_ = 0;
+
+    return *this;
+}
+
+ArgumentParser::Argument& ArgumentParser::Argument::Positional(size_t count) {
+    if (count == 0) {
+        throw std::runtime_error("Argument " + full_name_ + " must take at least one positional argument.");
+    }
+
+    if (count > 1 && !std::holds_alternative<std::nullptr_t>(storage_)) {
+        throw std::runtime_error("Argument " + full_name_ + " is stored into a single variable and cannot take several values.");
+    }
+
+    positional_arity_ = PositionalArity::kFixedPositional;
+    positional_count_ = count;
+
+    if (count > 1) {
+        multi_value_ = true;
+    }
+
+    return *this;
+}
+
+ArgumentParser::Argument& ArgumentParser::Argument::OptionalPositional() {
+    positional_arity_ = PositionalArity::kOptionalPositional;
+    positional_count_ = 1;
+
+    return *this;
+}
+
+ArgumentParser::Argument& ArgumentParser::Argument::Sink(std::function<void(const IntValues&)> sink, size_t batch_size) {
+    if (type_ != ArgumentType::kInteger) {
+        throw std::runtime_error("Only integer argument " + full_name_ + " can have a sink.");
+    }
+
+    if (storage_awaken_) {
+        throw std::runtime_error("Argument " + full_name_ + " is already stored into a variable.");
+    }
+
+    sink_ = std::move(sink);
+    sink_batch_size_ = std::max<size_t>(batch_size, 1);
 
     return *this;
 }
@@ -135,6 +412,14 @@ ArgumentParser::Argument& ArgumentParser::Argument::StoreValue(int32_t& value_st
         throw std::runtime_error("Cannot put integer value into non-integer variable.");
     }
 
+    if (sink_) {
+        throw std::runtime_error("Argument " + full_name_ + " passes its values to a sink.");
+    }
+
+    if (multi_value_) {
+        throw std::runtime_error("Argument " + full_name_ + " takes several values, use StoreValues.");
+    }
+
     storage_ = &value_storage;
     storage_awaken_ = true;
 
@@ -146,6 +431,10 @@ ArgumentParser::Argument& ArgumentParser::Argument::StoreValue(std::string& valu
         throw std::runtime_error("Cannot put string value into non-string variable.");
     }
 
+    if (multi_value_) {
+        throw std::runtime_error("Argument " + full_name_ + " takes several values, use StoreValues.");
+    }
+
     storage_ = &value_storage;
     storage_awaken_ = true;
 
@@ -168,6 +457,10 @@ ArgumentParser::Argument& ArgumentParser::Argument::StoreValues(std::vector<int3
         throw std::runtime_error("Cannot put integer value into non-integer variable.");
     }
 
+    if (sink_) {
+        throw std::runtime_error("Argument " + full_name_ + " passes its values to a sink.");
+    }
+
     multi_storage_ = &value_storage;
     storage_awaken_ = true;
 
@@ -186,24 +479,24 @@ ArgumentParser::Argument& ArgumentParser::Argument::StoreValues(std::vector<std:
 }
 
 void ArgumentParser::Argument::UpdateStorage() const {
-    if (!storage_awaken_) {
+    bool vector_storage = !std::holds_alternative<std::nullptr_t>(multi_storage_);
+
+    if (!storage_awaken_ || (!vector_storage && GetValuesCount() == 0)) {
         return;
     }
 
     if (type_ == ArgumentType::kInteger) {
-        if (multi_value_) {
+        if (vector_storage) {
             std::vector<int32_t>* storage_pointer = std::get<std::vector<int32_t>*>(multi_storage_);
             
-            for (const auto& value: values_) {
-                (*storage_pointer).emplace_back(std::stoi(value));
-            }
+            (*storage_pointer).insert((*storage_pointer).end(), int_values_.begin(), int_values_.end());
         } else {
             int32_t* storage_pointer = std::get<int32_t*>(storage_);
             
-            *storage_pointer = std::stoi(values_[0]);
+            *storage_pointer = int_values_[0];
         }
     } else if (type_ == ArgumentType::kString) {
-        if (multi_value_) {
+        if (vector_storage) {
             std::vector<std::string>* storage_pointer = std::get<std::vector<std::string>*>(multi_storage_);
 
             *storage_pointer = values_;
@@ -231,16 +524,41 @@ void ArgumentParser::Argument::UpdateStorage() const {
     }
 }
 
-void ArgumentParser::Argument::TakePositionals(const std::vector<std::string>& positionals) {
-    if (!takes_positional_) {
+void ArgumentParser::Argument::FlushSink() {
+    if (!sink_ || int_values_.Empty()) {
+        return;
+    }
+
+    sink_(int_values_);
+    sink_consumed_ += int_values_.Size();
+    int_values_.Clear();
+    default_in_use_ = false;
+}
+
+void ArgumentParser::Argument::TakePositionals(std::vector<std::string>::iterator first, std::vector<std::string>::iterator last, size_t max_values) {
+    if (positional_arity_ == PositionalArity::kNotPositional) {
         return;
     }
 
+    for (auto it = first; it != last; ++it) {
+        TakePositional(std::move(*it), max_values);
+    }
+}
+
+void ArgumentParser::Argument::TakePositional(std::string&& token, size_t max_values) {
     if (type_ == ArgumentType::kFlag) {
         throw std::runtime_error("Flags cannot take positional arguments.");
     }
 
-    values_ = positionals;
+    DropDefault();
+
+    if (delimiter_ != '\0') {
+        AddDelimited(token, max_values);
+    } else if (type_ == ArgumentType::kString) {
+        values_.emplace_back(std::move(token));
+    } else {
+        AddToken(token);
+    }
 }
 
 std::string ArgumentParser::Argument::Help() const {
@@ -259,6 +577,8 @@ std::string ArgumentParser::Argument::Help() const {
 
         if (type_ == ArgumentType::kInteger) {
             full_description += "int>";
+        } else if (type_ == ArgumentType::kMap) {
+            full_description += "key=value>";
         } else {
             full_description += "string>";
         }
@@ -267,10 +587,20 @@ std::string ArgumentParser::Argument::Help() const {
     full_description += ", ";
     full_description += " " + description_;
 
-    if (multi_value_) {
+    if (multi_value_ && type_ == ArgumentType::kMap) {
+        full_description += " [repeated, min entries = " + std::to_string(min_args_count_) + "]";
+    } else if (multi_value_) {
         full_description += " [repeated, min args = " + std::to_string(min_args_count_) + "]";
     }
 
+    if (type_ == ArgumentType::kMap && min_args_count_ == 0) {
+        full_description += " [optional]";
+    }
+
+    if (delimiter_ != '\0') {
+        full_description += " [separated by '" + std::string(1, delimiter_) + "']";
+    }
+
     if (!default_value_.empty()) {
         if (type_ == ArgumentType::kFlag) {
             if (default_value_ == "1") {
@@ -281,8 +611,12 @@ std::string ArgumentParser::Argument::Help() const {
         }
     }
 
-    if (takes_positional_) {
+    if (positional_arity_ == PositionalArity::kRestPositional) {
         full_description += " [takes positional arguments]";
+    } else if (positional_arity_ == PositionalArity::kFixedPositional) {
+        full_description += " [takes " + std::to_string(positional_count_) + " positional arguments]";
+    } else if (positional_arity_ == PositionalArity::kOptionalPositional) {
+        full_description += " [takes optional positional argument]";
     }
 
     full_description += "\n";
@@ -294,6 +628,9 @@ ArgumentParser::ArgParser::ArgParser(const std::string& parser_name)
     : parser_name_(parser_name)
     , short_help_('?')
     , help_called_(false)
+    , positional_route_resolved_(false)
+    , positional_route_(0)
+    , parsing_(false)
 {}
 
 std::vector<std::string> ParseMonoOption(const std::string& arg) {
@@ -328,75 +665,158 @@ std::vector<std::string> ParseMonoOption(const std::string& arg) {
 }
 
 bool ArgumentParser::ArgParser::Parse(const std::vector<std::string>& args) {
+    stats_ = ParseStats();
+
     if (args.size() == 0) {
         throw std::runtime_error("Zero arguments provided.");
     }
 
-    for (size_t i = 1; i < args.size(); ++i) {
-        if (args[i][0] == '-') {
-            if (args[i].size() < 2) {
-                throw std::runtime_error("Wrong argument: " + args[i]);
-            }
+    if (args.size() - 1 > limits_.max_tokens) {
+        throw std::runtime_error("Too many arguments: " + std::to_string(args.size() - 1) + ".");
+    }
 
-            bool full_name_argument = true;
+    for (size_t i = 1; i < args.size() && !help_called_; ++i) {
+        ParseToken(args[i]);
+    }
 
-            if (args[i][1] != '-') {
-                full_name_argument = false;
-            }
+    return FinishParse();
+}
 
-            std::vector<std::string> params;
-            bool is_flag = false;
+void ArgumentParser::ArgParser::ParseToken(const std::string& token) {
+    try {
+        HandleToken(token);
+    } catch (...) {
+        AbortParse();
+        throw;
+    }
+}
 
-            params = ParseMonoOption(args[i]);
+bool ArgumentParser::ArgParser::FinishParse() {
+    try {
+        return CompleteParse();
+    } catch (...) {
+        AbortParse();
+        throw;
+    }
+}
 
-            if (params[1].empty()) {
-                is_flag = true;
-                params[1] = "1";
-            }
+void ArgumentParser::ArgParser::AbortParse() {
+    positional_.clear();
+    positional_route_resolved_ = false;
+    parsing_ = false;
+}
 
-            if (full_name_argument) {
-                params[0] = params[0].substr(2);
+void ArgumentParser::ArgParser::HandleToken(const std::string& token) {
+    if (help_called_) {
+        return;
+    }
 
-                if (params[0] == full_help_) {
-                    help_called_ = true;
+    if (!parsing_) {
+        parsing_ = true;
+        stats_ = ParseStats();
+    }
 
-                    return true;
-                }
+    CountToken(token.size());
 
-                size_t index = GetIndex(params[0]);
+    if (token[0] != '-') {
+        if (!positional_route_resolved_) {
+            ResolvePositionalRoute();
+        }
 
-                if (is_flag && arguments_[index].GetType() != ArgumentType::kFlag) {
-                    throw std::runtime_error("Argument " + arguments_[index].GetFullName() + " is not a flag.");
-                }
+        CountValueBytes(token.size());
 
-                arguments_[index].AddValue(params[1]);
-            } else {
-                params[0] = params[0].substr(1);
+        if (positional_route_ < arguments_.size()) {
+            arguments_[positional_route_].TakePositional(std::string(token), limits_.max_values_per_argument);
+            CountValues(arguments_[positional_route_]);
+        } else {
+            positional_.emplace_back(token);
+        }
+
+        return;
+    }
 
-                for (auto short_name: params[0]) {
-                    if (short_name == short_help_) {
-                        help_called_ = true;
+    if (token.size() < 2) {
+        throw std::runtime_error("Wrong argument: " + token);
+    }
 
-                        return true;
-                    }
+    bool full_name_argument = true;
 
-                    size_t index = GetIndex(short_name);
+    if (token[1] != '-') {
+        full_name_argument = false;
+    }
+
+    std::vector<std::string> params;
+    bool is_flag = false;
+
+    params = ParseMonoOption(token);
+
+    if (params[1].empty()) {
+        is_flag = true;
+        params[1] = "1";
+    }
 
-                    if (is_flag && arguments_[index].GetType() != ArgumentType::kFlag) {
-                        throw std::runtime_error("Argument " + arguments_[index].GetFullName() + " is not a flag.");
-                    }
+    if (full_name_argument) {
+        params[0] = params[0].substr(2);
 
-                    arguments_[index].AddValue(params[1]);
-                }
+        if (params[0] == full_help_) {
+            help_called_ = true;
+
+            return;
+        }
+
+        size_t index = GetIndex(params[0]);
+
+        if (is_flag && arguments_[index].GetType() != ArgumentType::kFlag) {
+            throw std::runtime_error("Argument " + arguments_[index].GetFullName() + " is not a flag.");
+        }
+
+        CountValueBytes(params[1].size());
+        arguments_[index].AddValue(params[1], limits_.max_values_per_argument);
+        CountValues(arguments_[index]);
+    } else {
+        params[0] = params[0].substr(1);
+
+        for (auto short_name: params[0]) {
+            if (short_name == short_help_) {
+                help_called_ = true;
+
+                return;
             }
-        } else {
-            positional_.emplace_back(args[i]);
+
+            size_t index = GetIndex(short_name);
+
+            if (is_flag && arguments_[index].GetType() != ArgumentType::kFlag) {
+                throw std::runtime_error("Argument " + arguments_[index].GetFullName() + " is not a flag.");
+            }
+
+            CountValueBytes(params[1].size());
+            arguments_[index].AddValue(params[1], limits_.max_values_per_argument);
+            CountValues(arguments_[index]);
         }
     }
+}
 
-    TakePositionals();
+bool ArgumentParser::ArgParser::CompleteParse() {
+    if (!parsing_) {
+        stats_ = ParseStats();
+    }
 
-    if (!CheckValues()) {
+    if (help_called_) {
+        parsing_ = false;
+
+        return true;
+    }
+
+    bool positionals_taken = TakePositionals();
+    positional_route_resolved_ = false;
+    parsing_ = false;
+
+    for (auto& arg: arguments_) {
+        arg.FlushSink();
+        CountValues(arg);
+    }
+
+    if (!positionals_taken || !CheckValues()) {
         return false;
     }
 
@@ -406,6 +826,16 @@ bool ArgumentParser::ArgParser::Parse(const std::vector<std::string>& args) {
 }
 
 bool ArgumentParser::ArgParser::Parse(int argc, char** argv) {
+    if (argc > 0 && static_cast<size_t>(argc - 1) > limits_.max_tokens) {
+        throw std::runtime_error("Too many arguments: " + std::to_string(argc - 1) + ".");
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strlen(argv[i]) > limits_.max_token_length) {
+            throw std::runtime_error("Argument " + std::to_string(i) + " is longer than " + std::to_string(limits_.max_token_length) + " bytes.");
+        }
+    }
+
     std::vector<std::string> args;
 
     for (int i = 0; i < argc; ++i) {
@@ -442,6 +872,12 @@ ArgumentParser::Argument& ArgumentParser::ArgParser::AddStringArgument(const std
     return arguments_.back();
 }
 
+const ArgumentParser::IntValues& ArgumentParser::ArgParser::GetIntValues(const std::string& full_name) {
+    const Argument& arg = arguments_[GetIndex(full_name)];
+
+    return arg.GetIntValues();
+}
+
 std::string ArgumentParser::ArgParser::GetStringValue(const std::string& full_name, size_t index) {
     const Argument& arg = arguments_[GetIndex(full_name)];
 
@@ -481,6 +917,45 @@ int32_t ArgumentParser::ArgParser::GetIntValue(const std::string& full_name, siz
     return arg.GetIntValue(index);
 }
 
+ArgumentParser::Argument& ArgumentParser::ArgParser::AddMapArgument(char short_name, const std::string& full_name, const std::string& description) {
+    arguments_.emplace_back(ArgumentType::kMap, short_name, full_name, description);
+
+    if (!CheckOnAvailability(arguments_.back())) {
+        throw std::runtime_error("There is a collision between two arguments.\n"
+                                 "Use only unique short and full names.\n");
+    }
+
+    index_by_short_name_[short_name] = arguments_.size() - 1;
+    index_by_full_name_[full_name] = arguments_.size() - 1;
+
+    return arguments_.back();
+}
+
+ArgumentParser::Argument& ArgumentParser::ArgParser::AddMapArgument(const std::string& full_name, const std::string& description) {
+    arguments_.emplace_back(ArgumentType::kMap, full_name, description);
+
+    if (!CheckOnAvailability(arguments_.back())) {
+        throw std::runtime_error("There is a collision between two arguments.\n"
+                                 "Use only unique short and full names.\n");
+    }
+
+    index_by_full_name_[full_name] = arguments_.size() - 1;
+
+    return arguments_.back();
+}
+
+std::string_view ArgumentParser::ArgParser::GetMapValue(const std::string& full_name, std::string_view key) {
+    const Argument& arg = arguments_[GetIndex(full_name)];
+
+    return arg.GetMapValue(key);
+}
+
+const ArgumentParser::FlatStringMap& ArgumentParser::ArgParser::GetMap(const std::string& full_name) {
+    const Argument& arg = arguments_[GetIndex(full_name)];
+
+    return arg.GetMap();
+}
+
 ArgumentParser::Argument& ArgumentParser::ArgParser::AddFlag(char short_name, const std::string& full_name, const std::string& description) {
     arguments_.emplace_back(ArgumentType::kFlag, short_name, full_name, description);
 
@@ -516,6 +991,82 @@ bool ArgumentParser::ArgParser::GetFlag(const std::string& full_name) {
     return arg.GetFlag();
 }
 
+void ArgumentParser::ArgParser::AddRegisteredOptions() {
+    std::vector<const RegisteredOption*> options;
+
+    for (const RegisteredOption* option = RegisteredOption::GetHead(); option != nullptr; option = option->GetNext()) {
+        options.push_back(option);
+    }
+
+    std::reverse(options.begin(), options.end());
+
+    std::unordered_map<std::string_view, const RegisteredOption*> registered_full_names;
+    std::unordered_map<char, const RegisteredOption*> registered_short_names;
+
+    registered_full_names.reserve(options.size());
+    registered_short_names.reserve(options.size());
+
+    for (const RegisteredOption* option: options) {
+        std::string other_name;
+        std::string other_module = "the parser";
+        auto full_name_index = index_by_full_name_.find(option->GetFullName());
+        auto short_name_index = index_by_short_name_.find(option->GetShortName());
+        auto registered_full_name = registered_full_names.find(option->GetFullName());
+        auto registered_short_name = registered_short_names.find(option->GetShortName());
+
+        if (full_name_index != index_by_full_name_.end()) {
+            other_name = arguments_[full_name_index->second].GetFullName();
+        } else if (option->GetShortName() != '?' && short_name_index != index_by_short_name_.end()) {
+            other_name = arguments_[short_name_index->second].GetFullName();
+        } else if (registered_full_name != registered_full_names.end()) {
+            other_name = registered_full_name->second->GetFullName();
+            other_module = registered_full_name->second->GetModule();
+        } else if (option->GetShortName() != '?' && registered_short_name != registered_short_names.end()) {
+            other_name = registered_short_name->second->GetFullName();
+            other_module = registered_short_name->second->GetModule();
+        } else {
+            registered_full_names[option->GetFullName()] = option;
+
+            if (option->GetShortName() != '?') {
+                registered_short_names[option->GetShortName()] = option;
+            }
+
+            continue;
+        }
+
+        throw std::runtime_error("Option " + std::string(option->GetFullName()) + " from " + option->GetModule()
+                                 + " collides with " + other_name + " from " + other_module + ".");
+    }
+
+    std::vector<Argument> registered;
+
+    registered.reserve(options.size());
+
+    for (const RegisteredOption* option: options) {
+        registered.emplace_back(option->GetType(), option->GetShortName(), option->GetFullName(), option->GetDescription());
+
+        if (option->GetType() == ArgumentType::kFlag) {
+            registered.back().Default(false);
+        }
+
+        option->Configure(registered.back());
+    }
+
+    arguments_.reserve(arguments_.size() + registered.size());
+    index_by_short_name_.reserve(index_by_short_name_.size() + registered.size());
+    index_by_full_name_.reserve(index_by_full_name_.size() + registered.size());
+
+    for (auto& arg: registered) {
+        arguments_.push_back(std::move(arg));
+
+        if (arguments_.back().GetShortName() != '?') {
+            index_by_short_name_[arguments_.back().GetShortName()] = arguments_.size() - 1;
+        }
+
+        index_by_full_name_[arguments_.back().GetFullName()] = arguments_.size() - 1;
+    }
+}
+
 void ArgumentParser::ArgParser::AddHelp(char short_help, const std::string& full_help, const std::string& description) {
     short_help_ = short_help;
     full_help_ = full_help;
@@ -523,9 +1074,6 @@ void ArgumentParser::ArgParser::AddHelp(char short_help, const std::string& full
 }
 
 bool ArgumentParser::ArgParser::Help() {
-    help_of_all_parser_ += parser_name_ + "\n";
-    help_of_all_parser_ += description_ + "\n";
-
     return help_called_;
 }
 
@@ -566,15 +1114,106 @@ void ArgumentParser::ArgParser::UpdateStorages() const {
     }
 }
 
-void ArgumentParser::ArgParser::TakePositionals() {
+void ArgumentParser::ArgParser::SetLimits(const ParseLimits& limits) {
+    limits_ = limits;
+}
+
+const ArgumentParser::ParseLimits& ArgumentParser::ArgParser::GetLimits() const {
+    return limits_;
+}
+
+const ArgumentParser::ParseStats& ArgumentParser::ArgParser::GetStats() const {
+    return stats_;
+}
+
+void ArgumentParser::ArgParser::CountToken(size_t length) {
+    if (++stats_.tokens > limits_.max_tokens) {
+        throw std::runtime_error("Too many arguments: more than " + std::to_string(limits_.max_tokens) + ".");
+    }
+
+    if (length > limits_.max_token_length) {
+        throw std::runtime_error("Argument is longer than " + std::to_string(limits_.max_token_length) + " bytes.");
+    }
+
+    stats_.max_token_length = std::max(stats_.max_token_length, length);
+}
+
+void ArgumentParser::ArgParser::CountValueBytes(size_t length) {
+    stats_.value_bytes += length;
+
+    if (stats_.value_bytes > limits_.max_value_bytes) {
+        throw std::runtime_error("Values are longer than " + std::to_string(limits_.max_value_bytes) + " bytes in total.");
+    }
+}
+
+void ArgumentParser::ArgParser::CountValues(const Argument& arg) {
+    size_t values_count = arg.GetParsedValuesCount();
+
+    if (values_count > limits_.max_values_per_argument) {
+        throw std::runtime_error("Argument " + arg.GetFullName() + " has more than " + std::to_string(limits_.max_values_per_argument) + " values.");
+    }
+
+    stats_.max_values_per_argument = std::max(stats_.max_values_per_argument, values_count);
+}
+
+void ArgumentParser::ArgParser::ResolvePositionalRoute() {
+    positional_route_ = arguments_.size();
+    positional_route_resolved_ = true;
+
+    for (size_t i = 0; i < arguments_.size(); ++i) {
+        if (arguments_[i].GetPositionalArity() == PositionalArity::kNotPositional) {
+            continue;
+        }
+
+        if (positional_route_ != arguments_.size() || arguments_[i].GetPositionalArity() != PositionalArity::kRestPositional) {
+            positional_route_ = arguments_.size();
+
+            return;
+        }
+
+        positional_route_ = i;
+    }
+}
+
+bool ArgumentParser::ArgParser::TakePositionals() {
+    size_t reserved = 0;
+
+    for (const ArgumentParser::Argument& arg: arguments_) {
+        if (arg.GetPositionalArity() == PositionalArity::kFixedPositional) {
+            reserved += arg.GetPositionalCount();
+        }
+    }
+
+    auto current = positional_.begin();
+
     for (ArgumentParser::Argument& arg: arguments_) {
-        arg.TakePositionals(positional_);
+        size_t available = positional_.end() - current;
+        size_t taken = 0;
+
+        if (arg.GetPositionalArity() == PositionalArity::kFixedPositional) {
+            reserved -= arg.GetPositionalCount();
+            taken = std::min(arg.GetPositionalCount(), available);
+        } else if (arg.GetPositionalArity() == PositionalArity::kOptionalPositional) {
+            taken = (available > reserved ? 1 : 0);
+        } else if (arg.GetPositionalArity() == PositionalArity::kRestPositional) {
+            taken = (available > reserved ? available - reserved : 0);
+        } else {
+            continue;
+        }
+
+        arg.TakePositionals(current, current + taken, limits_.max_values_per_argument);
+        current += taken;
     }
+
+    bool all_taken = (current == positional_.end());
+    positional_.clear();
+
+    return all_taken;
 }
 
 std::string ArgumentParser::ArgParser::HelpDescription() {
-    Help();
-
+    help_of_all_parser_ = parser_name_ + "\n";
+    help_of_all_parser_ += description_ + "\n";
     help_of_all_parser_ += "\n";
 
     for (const auto& arg: arguments_) {
@@ -594,3 +1233,7 @@ std::string ArgumentParser::ArgParser::HelpDescription() {
 
     return help_of_all_parser_;
 }
+
+std::string ArgumentParser::ArgParser::SerializeValues() const {
+    return ParsedImage::Serialize(arguments_);
+}
@@ -1,17 +1,36 @@
 #pragma once
 
+#include "FlatMap.h"
+#include "IntValues.h"
+#include "ParsedImage.h"
+
 #include <cinttypes>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
 namespace ArgumentParser {
+    class RegisteredOption;
+
     enum ArgumentType {
         kInteger,
         kString,
-        kFlag
+        kFlag,
+        kMap
+    };
+
+    enum PositionalArity {
+        kNotPositional,
+        kFixedPositional,
+        kOptionalPositional,
+        kRestPositional
     };
 
     class Argument {
@@ -25,16 +44,28 @@ namespace ArgumentParser {
         std::string GetFullName() const;
         std::string GetDescription() const;
         ArgumentType GetType() const;
+        PositionalArity GetPositionalArity() const;
+        size_t GetPositionalCount() const;
         
-        std::string GetStringValue(size_t index = 0) const;
+        const std::string& GetStringValue(size_t index = 0) const;
         int32_t GetIntValue(size_t index = 0) const;
         bool GetFlag() const;
+        size_t GetValuesCount() const;
+        size_t GetParsedValuesCount() const;
+        const IntValues& GetIntValues() const;
+        const FlatStringMap& GetMap() const;
+        std::string_view GetMapValue(std::string_view key) const;
 
-        void AddValue(const std::string&);
+        void AddValue(const std::string&, size_t max_values = std::numeric_limits<size_t>::max());
 
         Argument& Default(const std::variant<int32_t, std::string, bool>& default_value);
         Argument& MultiValue(size_t min_args_count = 0);
+        Argument& Delimiter(char delimiter);
+        Argument& DuplicateKeys(DuplicatePolicy policy);
         Argument& Positional();
+        Argument& Positional(size_t count);
+        Argument& OptionalPositional();
+        Argument& Sink(std::function<void(const IntValues&)> sink, size_t batch_size = 1 << 16);
 
         Argument& StoreValue(int32_t& value_storage);
         Argument& StoreValue(std::string& value_storage);
@@ -45,10 +76,18 @@ namespace ArgumentParser {
 
         bool Check() const;
         void UpdateStorage() const;
-        void TakePositionals(const std::vector<std::string>& positionals);
+        void FlushSink();
+        void TakePositionals(std::vector<std::string>::iterator first, std::vector<std::string>::iterator last, size_t max_values = std::numeric_limits<size_t>::max());
+        void TakePositional(std::string&& token, size_t max_values = std::numeric_limits<size_t>::max());
 
         std::string Help() const;
     private:
+        void DropDefault();
+        void AddDelimited(std::string_view value, size_t max_values);
+        void AddToken(std::string_view token);
+        void AddIntToken(std::string_view token);
+        void AddMapToken(std::string_view token);
+
         ArgumentType type_;
 
         char short_name_;
@@ -56,7 +95,10 @@ namespace ArgumentParser {
         std::string description_;
 
         std::vector<std::string> values_;
+        IntValues int_values_;
+        FlatStringMap map_values_;
         std::string default_value_;
+        bool default_in_use_;
         
         bool storage_awaken_;
 
@@ -66,7 +108,70 @@ namespace ArgumentParser {
         uint32_t min_args_count_;
         std::variant<std::vector<int32_t>*, std::vector<std::string>*, std::nullptr_t> multi_storage_;
 
-        bool takes_positional_;
+        PositionalArity positional_arity_;
+        size_t positional_count_;
+
+        DuplicatePolicy duplicate_policy_;
+        char delimiter_;
+
+        std::function<void(const IntValues&)> sink_;
+        size_t sink_batch_size_;
+        size_t sink_consumed_;
+    };
+
+    template <typename T>
+    class OptionHandle {
+    public:
+        OptionHandle(const std::vector<Argument>& arguments, size_t index)
+            : arguments_(&arguments)
+            , index_(index)
+        {}
+
+        decltype(auto) Get(size_t index = 0) const {
+            const Argument& arg = (*arguments_)[index_];
+
+            if constexpr (std::is_same_v<T, int32_t>) {
+                return arg.GetIntValue(index);
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                return arg.GetStringValue(index);
+            } else {
+                static_assert(std::is_same_v<T, bool>, "Option handle must be int32_t, std::string or bool.");
+
+                return arg.GetFlag();
+            }
+        }
+
+        size_t Size() const {
+            return (*arguments_)[index_].GetValuesCount();
+        }
+    private:
+        const std::vector<Argument>* arguments_;
+        size_t index_;
+    };
+
+    template <typename Struct, typename T>
+    struct Field {
+        Field(const std::string& full_name, T Struct::* member)
+            : full_name(full_name)
+            , member(member)
+        {}
+
+        std::string full_name;
+        T Struct::* member;
+    };
+
+    struct ParseLimits {
+        size_t max_tokens = std::numeric_limits<size_t>::max();
+        size_t max_value_bytes = std::numeric_limits<size_t>::max();
+        size_t max_values_per_argument = std::numeric_limits<size_t>::max();
+        size_t max_token_length = std::numeric_limits<size_t>::max();
+    };
+
+    struct ParseStats {
+        size_t tokens = 0;
+        size_t value_bytes = 0;
+        size_t max_values_per_argument = 0;
+        size_t max_token_length = 0;
     };
 
     class ArgParser {
@@ -76,6 +181,14 @@ namespace ArgumentParser {
         bool Parse(const std::vector<std::string>& args);
         bool Parse(int argc, char** argv);
 
+        void ParseToken(const std::string& token);
+        bool FinishParse();
+        void AbortParse();
+
+        void SetLimits(const ParseLimits& limits);
+        const ParseLimits& GetLimits() const;
+        const ParseStats& GetStats() const;
+
         Argument& AddStringArgument(char short_name, const std::string& full_name, const std::string& description = "");
         Argument& AddStringArgument(const std::string& full_name, const std::string& description = "");
         std::string GetStringValue(const std::string& full_name, size_t index = 0);
@@ -83,14 +196,30 @@ namespace ArgumentParser {
         Argument& AddIntArgument(char short_name, const std::string& full_name, const std::string& description = "");
         Argument& AddIntArgument(const std::string& full_name, const std::string& description = "");
         int32_t GetIntValue(const std::string& full_name, size_t index = 0);
+        const IntValues& GetIntValues(const std::string& full_name);
+
+        Argument& AddMapArgument(char short_name, const std::string& full_name, const std::string& description = "");
+        Argument& AddMapArgument(const std::string& full_name, const std::string& description = "");
+        std::string_view GetMapValue(const std::string& full_name, std::string_view key);
+        const FlatStringMap& GetMap(const std::string& full_name);
 
         Argument& AddFlag(char short_name, const std::string& full_name, const std::string& description = "");
         Argument& AddFlag(const std::string& full_name, const std::string& description = "");
         bool GetFlag(const std::string& full_name);
 
+        template <typename T>
+        OptionHandle<T> GetHandle(const std::string& full_name);
+
+        template <typename Struct, typename... T>
+        void StoreFields(Struct& target, const Field<Struct, T>&... fields);
+
+        void AddRegisteredOptions();
+
         void AddHelp(char short_help, const std::string& full_help, const std::string& description = "");
         bool Help();
         std::string HelpDescription();
+
+        std::string SerializeValues() const;
     private:
         std::string parser_name_;
         
@@ -104,6 +233,13 @@ namespace ArgumentParser {
         std::vector<Argument> arguments_;
         std::vector<std::string> positional_;
 
+        bool positional_route_resolved_;
+        size_t positional_route_;
+
+        bool parsing_;
+        ParseLimits limits_;
+        ParseStats stats_;
+
         std::unordered_map<char, size_t> index_by_short_name_;
         std::unordered_map<std::string, size_t> index_by_full_name_;
 
@@ -113,6 +249,47 @@ namespace ArgumentParser {
         bool CheckOnAvailability(const Argument& arg) const;
         bool CheckValues() const;
         void UpdateStorages() const;
-        void TakePositionals();
+        void HandleToken(const std::string& token);
+        bool CompleteParse();
+
+        void CountToken(size_t length);
+        void CountValueBytes(size_t length);
+        void CountValues(const Argument& arg);
+        void ResolvePositionalRoute();
+        bool TakePositionals();
+
+        template <typename T>
+        void StoreField(T& storage, const std::string& full_name);
+        template <typename T>
+        void StoreField(std::vector<T>& storage, const std::string& full_name);
     };
+
+    template <typename T>
+    OptionHandle<T> ArgParser::GetHandle(const std::string& full_name) {
+        size_t index = GetIndex(full_name);
+        ArgumentType type = arguments_[index].GetType();
+
+        if ((std::is_same_v<T, int32_t> && type != ArgumentType::kInteger)
+            || (std::is_same_v<T, std::string> && type != ArgumentType::kString)
+            || (std::is_same_v<T, bool> && type != ArgumentType::kFlag)) {
+            throw std::runtime_error("Argument " + full_name + " does not match the type of the handle.");
+        }
+
+        return OptionHandle<T>(arguments_, index);
+    }
+
+    template <typename Struct, typename... T>
+    void ArgParser::StoreFields(Struct& target, const Field<Struct, T>&... fields) {
+        (StoreField(target.*(fields.member), fields.full_name), ...);
+    }
+
+    template <typename T>
+    void ArgParser::StoreField(T& storage, const std::string& full_name) {
+        arguments_[GetIndex(full_name)].StoreValue(storage);
+    }
+
+    template <typename T>
+    void ArgParser::StoreField(std::vector<T>& storage, const std::string& full_name) {
+        arguments_[GetIndex(full_name)].StoreValues(storage);
+    }
 }
@@ -0,0 +1,81 @@
+#include "Binary.h"
+
+#include <stdexcept>
+
+uint64_t ArgumentParser::Fnv1a(const char* data, size_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+void ArgumentParser::BinaryWriter::WriteU8(uint8_t value) {
+    buffer_ += static_cast<char>(value);
+}
+
+void ArgumentParser::BinaryWriter::WriteU32(uint32_t value) {
+    for (size_t i = 0; i < 4; ++i) {
+        WriteU8(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void ArgumentParser::BinaryWriter::WriteU64(uint64_t value) {
+    for (size_t i = 0; i < 8; ++i) {
+        WriteU8(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void ArgumentParser::BinaryWriter::WriteBytes(const char* data, size_t size) {
+    buffer_.append(data, size);
+}
+
+size_t ArgumentParser::BinaryWriter::Size() const {
+    return buffer_.size();
+}
+
+std::string& ArgumentParser::BinaryWriter::Buffer() {
+    return buffer_;
+}
+
+ArgumentParser::BinaryReader::BinaryReader(const char* data, size_t size)
+    : data_(data)
+    , size_(size)
+    , position_(0)
+{}
+
+uint32_t ArgumentParser::BinaryReader::ReadU32() {
+    const char* bytes = ReadBytes(4);
+    uint32_t value = 0;
+
+    for (size_t i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(bytes[i])) << (8 * i);
+    }
+
+    return value;
+}
+
+uint64_t ArgumentParser::BinaryReader::ReadU64() {
+    const char* bytes = ReadBytes(8);
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(bytes[i])) << (8 * i);
+    }
+
+    return value;
+}
+
+const char* ArgumentParser::BinaryReader::ReadBytes(size_t size) {
+    if (size > size_ - position_) {
+        throw std::runtime_error("Unexpected end of binary data.");
+    }
+
+    const char* result = data_ + position_;
+    position_ += size;
+
+    return result;
+}
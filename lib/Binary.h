@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cinttypes>
+#include <string>
+
+namespace ArgumentParser {
+    uint64_t Fnv1a(const char* data, size_t size);
+
+    class BinaryWriter {
+    public:
+        void WriteU8(uint8_t value);
+        void WriteU32(uint32_t value);
+        void WriteU64(uint64_t value);
+        void WriteBytes(const char* data, size_t size);
+
+        size_t Size() const;
+        std::string& Buffer();
+    private:
+        std::string buffer_;
+    };
+
+    class BinaryReader {
+    public:
+        BinaryReader(const char* data, size_t size);
+
+        uint32_t ReadU32();
+        uint64_t ReadU64();
+        const char* ReadBytes(size_t size);
+    private:
+        const char* data_;
+        size_t size_;
+        size_t position_;
+    };
+}
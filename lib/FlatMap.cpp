@@ -0,0 +1,138 @@
+#include "FlatMap.h"
+#include "Binary.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    const size_t kMinBlockSize = 4096;
+    const size_t kMinSlotsCount = 16;
+}
+
+ArgumentParser::FlatStringMap::FlatStringMap()
+    : block_size_(0)
+    , block_used_(0)
+{}
+
+ArgumentParser::FlatStringMap::FlatStringMap(const FlatStringMap& other)
+    : entries_(other.entries_)
+    , slots_(other.slots_)
+    , block_size_(0)
+    , block_used_(0)
+{
+    for (auto& entry: entries_) {
+        entry.key = Store(entry.key);
+        entry.value = Store(entry.value);
+    }
+}
+
+ArgumentParser::FlatStringMap& ArgumentParser::FlatStringMap::operator=(const FlatStringMap& other) {
+    if (this != &other) {
+        *this = FlatStringMap(other);
+    }
+
+    return *this;
+}
+
+bool ArgumentParser::FlatStringMap::Insert(std::string_view key, std::string_view value, DuplicatePolicy policy) {
+    if ((entries_.size() + 1) * 2 > slots_.size()) {
+        Grow();
+    }
+
+    uint64_t hash = Fnv1a(key.data(), key.size());
+    size_t slot = FindSlot(key, hash);
+
+    if (slots_[slot] != 0) {
+        if (policy == DuplicatePolicy::kRejectDuplicates) {
+            return false;
+        }
+
+        if (policy == DuplicatePolicy::kKeepLast) {
+            entries_[slots_[slot] - 1].value = value;
+        }
+
+        return true;
+    }
+
+    entries_.push_back({key, value, hash});
+    slots_[slot] = static_cast<uint32_t>(entries_.size());
+
+    return true;
+}
+
+std::string_view ArgumentParser::FlatStringMap::Store(std::string_view text) {
+    if (blocks_.empty() || text.size() > block_size_ - block_used_) {
+        block_size_ = std::max({kMinBlockSize, block_size_ * 2, text.size()});
+        block_used_ = 0;
+        blocks_.emplace_back(new char[block_size_]);
+    }
+
+    char* destination = blocks_.back().get() + block_used_;
+
+    if (!text.empty()) {
+        std::memcpy(destination, text.data(), text.size());
+    }
+
+    block_used_ += text.size();
+
+    return std::string_view(destination, text.size());
+}
+
+const std::string_view* ArgumentParser::FlatStringMap::Find(std::string_view key) const {
+    if (slots_.empty()) {
+        return nullptr;
+    }
+
+    size_t slot = FindSlot(key, Fnv1a(key.data(), key.size()));
+
+    if (slots_[slot] == 0) {
+        return nullptr;
+    }
+
+    return &entries_[slots_[slot] - 1].value;
+}
+
+bool ArgumentParser::FlatStringMap::Contains(std::string_view key) const {
+    return Find(key) != nullptr;
+}
+
+size_t ArgumentParser::FlatStringMap::Size() const {
+    return entries_.size();
+}
+
+const std::vector<ArgumentParser::MapEntry>& ArgumentParser::FlatStringMap::GetEntries() const {
+    return entries_;
+}
+
+size_t ArgumentParser::FlatStringMap::FindSlot(std::string_view key, uint64_t hash) const {
+    size_t mask = slots_.size() - 1;
+    size_t slot = hash & mask;
+
+    while (slots_[slot] != 0) {
+        const MapEntry& entry = entries_[slots_[slot] - 1];
+
+        if (entry.hash == hash && entry.key == key) {
+            break;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+void ArgumentParser::FlatStringMap::Grow() {
+    slots_.assign(std::max(kMinSlotsCount, slots_.size() * 2), 0);
+
+    size_t mask = slots_.size() - 1;
+
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        size_t slot = entries_[i].hash & mask;
+
+        while (slots_[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+
+        slots_[slot] = static_cast<uint32_t>(i + 1);
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cinttypes>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace ArgumentParser {
+    enum DuplicatePolicy {
+        kKeepFirst,
+        kKeepLast,
+        kRejectDuplicates
+    };
+
+    struct MapEntry {
+        std::string_view key;
+        std::string_view value;
+        uint64_t hash;
+    };
+
+    class FlatStringMap {
+    public:
+        FlatStringMap();
+        FlatStringMap(const FlatStringMap& other);
+        FlatStringMap(FlatStringMap&& other) = default;
+
+        FlatStringMap& operator=(const FlatStringMap& other);
+        FlatStringMap& operator=(FlatStringMap&& other) = default;
+
+        bool Insert(std::string_view key, std::string_view value, DuplicatePolicy policy);
+        std::string_view Store(std::string_view text);
+
+        const std::string_view* Find(std::string_view key) const;
+        bool Contains(std::string_view key) const;
+        size_t Size() const;
+
+        const std::vector<MapEntry>& GetEntries() const;
+    private:
+        std::vector<MapEntry> entries_;
+        std::vector<uint32_t> slots_;
+
+        std::vector<std::unique_ptr<char[]>> blocks_;
+        size_t block_size_;
+        size_t block_used_;
+
+        size_t FindSlot(std::string_view key, uint64_t hash) const;
+        void Grow();
+    };
+}
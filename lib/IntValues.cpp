@@ -0,0 +1,112 @@
+#include "IntValues.h"
+
+#include <algorithm>
+
+ArgumentParser::IntValues::Iterator::Iterator(const IntValues* values, size_t segment, size_t position)
+    : values_(values)
+    , segment_(segment)
+    , position_(position)
+{}
+
+int32_t ArgumentParser::IntValues::Iterator::operator*() const {
+    return values_->GetSegmentValue(values_->segments_[segment_], position_);
+}
+
+ArgumentParser::IntValues::Iterator& ArgumentParser::IntValues::Iterator::operator++() {
+    if (++position_ == values_->segments_[segment_].count) {
+        ++segment_;
+        position_ = 0;
+    }
+
+    return *this;
+}
+
+ArgumentParser::IntValues::Iterator ArgumentParser::IntValues::Iterator::operator++(int) {
+    Iterator previous = *this;
+    ++(*this);
+
+    return previous;
+}
+
+bool ArgumentParser::IntValues::Iterator::operator==(const Iterator& other) const {
+    return segment_ == other.segment_ && position_ == other.position_;
+}
+
+bool ArgumentParser::IntValues::Iterator::operator!=(const Iterator& other) const {
+    return !(*this == other);
+}
+
+ArgumentParser::IntValues::IntValues()
+    : size_(0)
+{}
+
+void ArgumentParser::IntValues::Add(int32_t value) {
+    if (segments_.empty() || !segments_.back().literal) {
+        segments_.push_back({size_, 0, 0, 0, literals_.size(), true});
+    }
+
+    literals_.push_back(value);
+    ++segments_.back().count;
+    ++size_;
+}
+
+void ArgumentParser::IntValues::AddRange(int32_t start, int32_t step, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    segments_.push_back({size_, count, start, step, 0, false});
+    size_ += count;
+}
+
+void ArgumentParser::IntValues::Clear() {
+    segments_.clear();
+    literals_.clear();
+    size_ = 0;
+}
+
+size_t ArgumentParser::IntValues::Size() const {
+    return size_;
+}
+
+bool ArgumentParser::IntValues::Empty() const {
+    return size_ == 0;
+}
+
+int32_t ArgumentParser::IntValues::operator[](size_t index) const {
+    auto segment = std::upper_bound(segments_.begin(), segments_.end(), index, [](size_t value, const IntSegment& segment) {
+        return value < segment.offset;
+    });
+
+    --segment;
+
+    return GetSegmentValue(*segment, index - segment->offset);
+}
+
+ArgumentParser::IntValues::Iterator ArgumentParser::IntValues::begin() const {
+    return Iterator(this, 0, 0);
+}
+
+ArgumentParser::IntValues::Iterator ArgumentParser::IntValues::end() const {
+    return Iterator(this, segments_.size(), 0);
+}
+
+const std::vector<ArgumentParser::IntSegment>& ArgumentParser::IntValues::GetSegments() const {
+    return segments_;
+}
+
+int32_t ArgumentParser::IntValues::GetSegmentValue(const IntSegment& segment, size_t position) const {
+    if (segment.literal) {
+        return literals_[segment.literals_offset + position];
+    }
+
+    return static_cast<int32_t>(segment.start + segment.step * static_cast<int64_t>(position));
+}
+
+const int32_t* ArgumentParser::IntValues::GetSegmentLiterals(const IntSegment& segment) const {
+    if (!segment.literal) {
+        return nullptr;
+    }
+
+    return literals_.data() + segment.literals_offset;
+}
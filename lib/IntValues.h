@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace ArgumentParser {
+    struct IntSegment {
+        size_t offset;
+        size_t count;
+        int64_t start;
+        int64_t step;
+        size_t literals_offset;
+        bool literal;
+    };
+
+    class IntValues {
+    public:
+        class Iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = int32_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const int32_t*;
+            using reference = int32_t;
+
+            Iterator(const IntValues* values, size_t segment, size_t position);
+
+            int32_t operator*() const;
+            Iterator& operator++();
+            Iterator operator++(int);
+
+            bool operator==(const Iterator& other) const;
+            bool operator!=(const Iterator& other) const;
+        private:
+            const IntValues* values_;
+            size_t segment_;
+            size_t position_;
+        };
+
+        IntValues();
+
+        void Add(int32_t value);
+        void AddRange(int32_t start, int32_t step, size_t count);
+        void Clear();
+
+        size_t Size() const;
+        bool Empty() const;
+        int32_t operator[](size_t index) const;
+
+        Iterator begin() const;
+        Iterator end() const;
+
+        const std::vector<IntSegment>& GetSegments() const;
+        int32_t GetSegmentValue(const IntSegment& segment, size_t position) const;
+        const int32_t* GetSegmentLiterals(const IntSegment& segment) const;
+    private:
+        std::vector<IntSegment> segments_;
+        std::vector<int32_t> literals_;
+        size_t size_;
+    };
+}
@@ -0,0 +1,387 @@
+#include "ParsedImage.h"
+#include "ArgParser.h"
+#include "Binary.h"
+
+#include <stdexcept>
+
+namespace {
+    const uint32_t kImageMagic = 0x52505041;  // "APPR"
+    const uint32_t kImageVersion = 2;
+    const size_t kImageHeaderSize = 32;
+
+    const size_t kRecordSize = 64;
+    const size_t kRecordNameField = 0;
+    const size_t kRecordTypeField = 16;
+    const size_t kRecordCountField = 24;
+    const size_t kRecordDataField = 32;
+    const size_t kRecordDataCountField = 40;
+    const size_t kRecordAuxField = 48;
+    const size_t kRecordAuxCountField = 56;
+
+    const size_t kSegmentSize = 48;
+    const size_t kSegmentOffsetField = 0;
+    const size_t kSegmentCountField = 8;
+    const size_t kSegmentStartField = 16;
+    const size_t kSegmentStepField = 24;
+    const size_t kSegmentLiteralsOffsetField = 32;
+    const size_t kSegmentLiteralField = 40;
+
+    const size_t kStringReferenceSize = 16;
+    const size_t kReferenceOffsetField = 0;
+    const size_t kReferenceSizeField = 8;
+
+    const size_t kMapEntrySize = 32;
+    const size_t kMapEntryKeyField = 0;
+    const size_t kMapEntryValueField = 16;
+
+    uint64_t LoadU64(const char* data) {
+        uint64_t value = 0;
+
+        for (size_t i = 0; i < 8; ++i) {
+            value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+        }
+
+        return value;
+    }
+
+    uint32_t LoadU32(const char* data) {
+        uint32_t value = 0;
+
+        for (size_t i = 0; i < 4; ++i) {
+            value |= static_cast<uint32_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+        }
+
+        return value;
+    }
+
+    size_t SlotsCountFor(size_t entries_count) {
+        size_t slots_count = 1;
+
+        while (slots_count < entries_count * 2) {
+            slots_count *= 2;
+        }
+
+        return slots_count;
+    }
+
+    std::vector<uint32_t> BuildSlots(const std::vector<uint64_t>& hashes) {
+        std::vector<uint32_t> slots(SlotsCountFor(hashes.size()), 0);
+        size_t mask = slots.size() - 1;
+
+        for (size_t i = 0; i < hashes.size(); ++i) {
+            size_t slot = hashes[i] & mask;
+
+            while (slots[slot] != 0) {
+                slot = (slot + 1) & mask;
+            }
+
+            slots[slot] = static_cast<uint32_t>(i + 1);
+        }
+
+        return slots;
+    }
+
+    void WriteStringReference(ArgumentParser::BinaryWriter& data, ArgumentParser::BinaryWriter& blob, std::string_view value) {
+        data.WriteU64(blob.Size());
+        data.WriteU64(value.size());
+        blob.WriteBytes(value.data(), value.size());
+    }
+}
+
+ArgumentParser::ParsedImage::ParsedImage(const char* data, size_t size)
+    : data_(data)
+    , size_(size)
+{
+    if (size_ < kImageHeaderSize) {
+        throw std::runtime_error("Parsed image is too small.");
+    }
+
+    BinaryReader header(data_, kImageHeaderSize);
+
+    if (header.ReadU32() != kImageMagic || header.ReadU32() != kImageVersion) {
+        throw std::runtime_error("Parsed image has an unknown format.");
+    }
+
+    if (header.ReadU64() != Fnv1a(data_ + kImageHeaderSize, size_ - kImageHeaderSize)) {
+        throw std::runtime_error("Parsed image is corrupted.");
+    }
+
+    arguments_count_ = header.ReadU32();
+    slots_count_ = header.ReadU32();
+    blob_offset_ = header.ReadU64();
+
+    if (slots_count_ == 0 || (slots_count_ & (slots_count_ - 1)) != 0 || arguments_count_ >= slots_count_) {
+        throw std::runtime_error("Parsed image has a broken slot table.");
+    }
+
+    CheckRange(kImageHeaderSize, slots_count_, 4);
+    CheckRange(kImageHeaderSize + slots_count_ * 4, arguments_count_, kRecordSize);
+    CheckRange(blob_offset_, 0, 1);
+}
+
+std::string ArgumentParser::ParsedImage::Serialize(const std::vector<Argument>& arguments) {
+    size_t slots_count = SlotsCountFor(arguments.size());
+    size_t data_offset = kImageHeaderSize + slots_count * 4 + arguments.size() * kRecordSize;
+
+    std::vector<uint64_t> hashes;
+    BinaryWriter records;
+    BinaryWriter data;
+    BinaryWriter blob;
+
+    for (const auto& arg: arguments) {
+        std::string full_name = arg.GetFullName();
+        hashes.push_back(Fnv1a(full_name.data(), full_name.size()));
+
+        WriteStringReference(records, blob, full_name);
+        records.WriteU64(static_cast<uint64_t>(arg.GetType()));
+        records.WriteU64(arg.GetType() == ArgumentType::kFlag ? 1 : arg.GetValuesCount());
+        records.WriteU64(data_offset + data.Size());
+
+        if (arg.GetType() == ArgumentType::kInteger) {
+            const IntValues& values = arg.GetIntValues();
+            size_t literals_count = 0;
+
+            for (const auto& segment: values.GetSegments()) {
+                data.WriteU64(segment.offset);
+                data.WriteU64(segment.count);
+                data.WriteU64(static_cast<uint64_t>(segment.start));
+                data.WriteU64(static_cast<uint64_t>(segment.step));
+                data.WriteU64(segment.literal ? literals_count : 0);
+                data.WriteU64(segment.literal);
+
+                if (segment.literal) {
+                    literals_count += segment.count;
+                }
+            }
+
+            records.WriteU64(values.GetSegments().size());
+            records.WriteU64(data_offset + data.Size());
+            records.WriteU64(literals_count);
+
+            for (const auto& segment: values.GetSegments()) {
+                for (size_t i = 0; segment.literal && i < segment.count; ++i) {
+                    data.WriteU32(static_cast<uint32_t>(values.GetSegmentValue(segment, i)));
+                }
+            }
+        } else if (arg.GetType() == ArgumentType::kString) {
+            for (size_t i = 0; i < arg.GetValuesCount(); ++i) {
+                WriteStringReference(data, blob, arg.GetStringValue(i));
+            }
+
+            records.WriteU64(arg.GetValuesCount());
+            records.WriteU64(0);
+            records.WriteU64(0);
+        } else if (arg.GetType() == ArgumentType::kMap) {
+            const std::vector<MapEntry>& entries = arg.GetMap().GetEntries();
+            std::vector<uint64_t> key_hashes;
+
+            for (const auto& entry: entries) {
+                WriteStringReference(data, blob, entry.key);
+                WriteStringReference(data, blob, entry.value);
+                key_hashes.push_back(entry.hash);
+            }
+
+            std::vector<uint32_t> slots = BuildSlots(key_hashes);
+
+            records.WriteU64(entries.size());
+            records.WriteU64(data_offset + data.Size());
+            records.WriteU64(slots.size());
+
+            for (uint32_t slot: slots) {
+                data.WriteU32(slot);
+            }
+        } else {
+            data.WriteU64(arg.GetFlag());
+
+            records.WriteU64(1);
+            records.WriteU64(0);
+            records.WriteU64(0);
+        }
+    }
+
+    BinaryWriter body;
+
+    for (uint32_t slot: BuildSlots(hashes)) {
+        body.WriteU32(slot);
+    }
+
+    body.WriteBytes(records.Buffer().data(), records.Size());
+    body.WriteBytes(data.Buffer().data(), data.Size());
+    body.WriteBytes(blob.Buffer().data(), blob.Size());
+
+    BinaryWriter image;
+
+    image.WriteU32(kImageMagic);
+    image.WriteU32(kImageVersion);
+    image.WriteU64(Fnv1a(body.Buffer().data(), body.Size()));
+    image.WriteU32(static_cast<uint32_t>(arguments.size()));
+    image.WriteU32(static_cast<uint32_t>(slots_count));
+    image.WriteU64(data_offset + data.Size());
+    image.WriteBytes(body.Buffer().data(), body.Size());
+
+    return image.Buffer();
+}
+
+size_t ArgumentParser::ParsedImage::GetValuesCount(std::string_view full_name) const {
+    size_t record = FindRecord(full_name, 0xFF);
+
+    return LoadU64At(record + kRecordCountField);
+}
+
+std::string_view ArgumentParser::ParsedImage::GetStringValue(std::string_view full_name, size_t index) const {
+    size_t record = FindRecord(full_name, ArgumentType::kString);
+
+    if (index >= LoadU64At(record + kRecordCountField)) {
+        throw std::runtime_error("Argument " + std::string(full_name) + " has no value with index " + std::to_string(index) + ".");
+    }
+
+    size_t references = CheckRange(LoadU64At(record + kRecordDataField), LoadU64At(record + kRecordCountField), kStringReferenceSize);
+
+    return GetBlobString(references + index * kStringReferenceSize);
+}
+
+int32_t ArgumentParser::ParsedImage::GetIntValue(std::string_view full_name, size_t index) const {
+    size_t record = FindRecord(full_name, ArgumentType::kInteger);
+
+    if (index >= LoadU64At(record + kRecordCountField)) {
+        throw std::runtime_error("Argument " + std::string(full_name) + " has no value with index " + std::to_string(index) + ".");
+    }
+
+    size_t segments_count = LoadU64At(record + kRecordDataCountField);
+    size_t segments = CheckRange(LoadU64At(record + kRecordDataField), segments_count, kSegmentSize);
+    size_t left = 0;
+    size_t right = segments_count;
+
+    if (segments_count == 0) {
+        throw std::runtime_error("Parsed image is truncated.");
+    }
+
+    while (right - left > 1) {
+        size_t middle = (left + right) / 2;
+
+        if (LoadU64At(segments + middle * kSegmentSize + kSegmentOffsetField) <= index) {
+            left = middle;
+        } else {
+            right = middle;
+        }
+    }
+
+    size_t segment = segments + left * kSegmentSize;
+    uint64_t position = index - LoadU64At(segment + kSegmentOffsetField);
+
+    if (position >= LoadU64At(segment + kSegmentCountField)) {
+        throw std::runtime_error("Parsed image is truncated.");
+    }
+
+    if (LoadU64At(segment + kSegmentLiteralField) != 0) {
+        size_t literals_count = LoadU64At(record + kRecordAuxCountField);
+        size_t literals = CheckRange(LoadU64At(record + kRecordAuxField), literals_count, 4);
+        uint64_t literal = LoadU64At(segment + kSegmentLiteralsOffsetField) + position;
+
+        if (literal >= literals_count) {
+            throw std::runtime_error("Parsed image is truncated.");
+        }
+
+        return static_cast<int32_t>(LoadU32At(literals + literal * 4));
+    }
+
+    int64_t start = static_cast<int64_t>(LoadU64At(segment + kSegmentStartField));
+    int64_t step = static_cast<int64_t>(LoadU64At(segment + kSegmentStepField));
+
+    return static_cast<int32_t>(start + step * static_cast<int64_t>(position));
+}
+
+bool ArgumentParser::ParsedImage::GetFlag(std::string_view full_name) const {
+    size_t record = FindRecord(full_name, ArgumentType::kFlag);
+
+    return LoadU64At(LoadU64At(record + kRecordDataField)) != 0;
+}
+
+std::string_view ArgumentParser::ParsedImage::GetMapValue(std::string_view full_name, std::string_view key) const {
+    size_t record = FindRecord(full_name, ArgumentType::kMap);
+    size_t entries_count = LoadU64At(record + kRecordDataCountField);
+    size_t slots_count = LoadU64At(record + kRecordAuxCountField);
+    size_t entries = CheckRange(LoadU64At(record + kRecordDataField), entries_count, kMapEntrySize);
+    size_t slots = CheckRange(LoadU64At(record + kRecordAuxField), slots_count, 4);
+
+    if (slots_count == 0 || (slots_count & (slots_count - 1)) != 0) {
+        throw std::runtime_error("Parsed image has a broken slot table.");
+    }
+
+    size_t mask = slots_count - 1;
+    size_t slot = Fnv1a(key.data(), key.size()) & mask;
+
+    for (size_t probes = 0; probes < slots_count && LoadU32At(slots + slot * 4) != 0; ++probes) {
+        size_t entry_index = LoadU32At(slots + slot * 4) - 1;
+
+        if (entry_index >= entries_count) {
+            throw std::runtime_error("Parsed image has a broken slot table.");
+        }
+
+        size_t entry = entries + entry_index * kMapEntrySize;
+
+        if (GetBlobString(entry + kMapEntryKeyField) == key) {
+            return GetBlobString(entry + kMapEntryValueField);
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    throw std::runtime_error("Argument " + std::string(full_name) + " has no key " + std::string(key) + ".");
+}
+
+size_t ArgumentParser::ParsedImage::FindRecord(std::string_view full_name, uint8_t type) const {
+    size_t slots = kImageHeaderSize;
+    size_t records = slots + slots_count_ * 4;
+    size_t mask = slots_count_ - 1;
+    size_t slot = Fnv1a(full_name.data(), full_name.size()) & mask;
+
+    for (size_t probes = 0; probes < slots_count_ && LoadU32At(slots + slot * 4) != 0; ++probes) {
+        size_t record_index = LoadU32At(slots + slot * 4) - 1;
+
+        if (record_index >= arguments_count_) {
+            throw std::runtime_error("Parsed image has a broken slot table.");
+        }
+
+        size_t record = records + record_index * kRecordSize;
+
+        if (GetBlobString(record + kRecordNameField) == full_name) {
+            if (type != 0xFF && LoadU64At(record + kRecordTypeField) != type) {
+                throw std::runtime_error("Argument " + std::string(full_name) + " has another type.");
+            }
+
+            return record;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    throw std::runtime_error("No such argument as " + std::string(full_name));
+}
+
+std::string_view ArgumentParser::ParsedImage::GetBlobString(size_t reference) const {
+    uint64_t offset = LoadU64At(reference + kReferenceOffsetField);
+    uint64_t size = LoadU64At(reference + kReferenceSizeField);
+
+    if (offset > size_ - blob_offset_) {
+        throw std::runtime_error("Parsed image is truncated.");
+    }
+
+    return std::string_view(data_ + CheckRange(blob_offset_ + offset, size, 1), size);
+}
+
+size_t ArgumentParser::ParsedImage::CheckRange(uint64_t offset, uint64_t count, size_t element_size) const {
+    if (offset > size_ || count > (size_ - offset) / element_size) {
+        throw std::runtime_error("Parsed image is truncated.");
+    }
+
+    return offset;
+}
+
+uint64_t ArgumentParser::ParsedImage::LoadU64At(uint64_t offset) const {
+    return LoadU64(data_ + CheckRange(offset, 8, 1));
+}
+
+uint32_t ArgumentParser::ParsedImage::LoadU32At(uint64_t offset) const {
+    return LoadU32(data_ + CheckRange(offset, 4, 1));
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cinttypes>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ArgumentParser {
+    class Argument;
+
+    class ParsedImage {
+    public:
+        ParsedImage(const char* data, size_t size);
+
+        static std::string Serialize(const std::vector<Argument>& arguments);
+
+        size_t GetValuesCount(std::string_view full_name) const;
+        std::string_view GetStringValue(std::string_view full_name, size_t index = 0) const;
+        int32_t GetIntValue(std::string_view full_name, size_t index = 0) const;
+        bool GetFlag(std::string_view full_name) const;
+        std::string_view GetMapValue(std::string_view full_name, std::string_view key) const;
+    private:
+        const char* data_;
+        size_t size_;
+
+        size_t arguments_count_;
+        size_t slots_count_;
+        size_t blob_offset_;
+
+        size_t FindRecord(std::string_view full_name, uint8_t type) const;
+        std::string_view GetBlobString(size_t reference) const;
+
+        size_t CheckRange(uint64_t offset, uint64_t count, size_t element_size) const;
+        uint64_t LoadU64At(uint64_t offset) const;
+        uint32_t LoadU32At(uint64_t offset) const;
+    };
+}
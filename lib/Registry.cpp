@@ -0,0 +1,57 @@
+#include "Registry.h"
+
+#include <atomic>
+
+namespace {
+    std::atomic<const ArgumentParser::RegisteredOption*> registry_head(nullptr);
+}
+
+ArgumentParser::RegisteredOption::RegisteredOption(const char* module, ArgumentType type, char short_name, const char* full_name, const char* description, void (*configure)(Argument&))
+    : module_(module)
+    , type_(type)
+    , short_name_(short_name)
+    , full_name_(full_name)
+    , description_(description)
+    , configure_(configure)
+    , next_(registry_head.load(std::memory_order_relaxed))
+{
+    while (!registry_head.compare_exchange_weak(next_, this, std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+ArgumentParser::RegisteredOption::RegisteredOption(const char* module, ArgumentType type, const char* full_name, const char* description, void (*configure)(Argument&))
+    : RegisteredOption(module, type, '?', full_name, description, configure)
+{}
+
+const char* ArgumentParser::RegisteredOption::GetModule() const {
+    return module_;
+}
+
+ArgumentParser::ArgumentType ArgumentParser::RegisteredOption::GetType() const {
+    return type_;
+}
+
+char ArgumentParser::RegisteredOption::GetShortName() const {
+    return short_name_;
+}
+
+const char* ArgumentParser::RegisteredOption::GetFullName() const {
+    return full_name_;
+}
+
+const char* ArgumentParser::RegisteredOption::GetDescription() const {
+    return description_;
+}
+
+void ArgumentParser::RegisteredOption::Configure(Argument& arg) const {
+    if (configure_ != nullptr) {
+        configure_(arg);
+    }
+}
+
+const ArgumentParser::RegisteredOption* ArgumentParser::RegisteredOption::GetNext() const {
+    return next_;
+}
+
+const ArgumentParser::RegisteredOption* ArgumentParser::RegisteredOption::GetHead() {
+    return registry_head.load(std::memory_order_acquire);
+}
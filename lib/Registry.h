@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ArgParser.h"
+
+#define ARGPARSER_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define ARGPARSER_CONCAT(lhs, rhs) ARGPARSER_CONCAT_IMPL(lhs, rhs)
+
+#define ARGPARSER_REGISTER_OPTION(...) \
+    static const ::ArgumentParser::RegisteredOption ARGPARSER_CONCAT(argparser_registered_option_, __LINE__)(__FILE__, __VA_ARGS__)
+
+namespace ArgumentParser {
+    class RegisteredOption {
+    public:
+        RegisteredOption(const char* module, ArgumentType type, char short_name, const char* full_name, const char* description = "", void (*configure)(Argument&) = nullptr);
+        RegisteredOption(const char* module, ArgumentType type, const char* full_name, const char* description = "", void (*configure)(Argument&) = nullptr);
+
+        const char* GetModule() const;
+        ArgumentType GetType() const;
+        char GetShortName() const;
+        const char* GetFullName() const;
+        const char* GetDescription() const;
+
+        void Configure(Argument& arg) const;
+
+        const RegisteredOption* GetNext() const;
+        static const RegisteredOption* GetHead();
+    private:
+        const char* module_;
+        ArgumentType type_;
+        char short_name_;
+        const char* full_name_;
+        const char* description_;
+        void (*configure_)(Argument&);
+
+        const RegisteredOption* next_;
+    };
+}
@@ -0,0 +1,84 @@
+#include "StreamParser.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+ArgumentParser::StreamParser::StreamParser(ArgParser& parser, bool null_separated, size_t max_token_length)
+    : parser_(parser)
+    , null_separated_(null_separated)
+    , max_token_length_(max_token_length)
+{}
+
+void ArgumentParser::StreamParser::Feed(const char* data, size_t size) {
+    size_t token_begin = 0;
+
+    for (size_t i = 0; i < size; ++i) {
+        if (!IsSeparator(data[i])) {
+            continue;
+        }
+
+        if (!pending_.empty()) {
+            CheckTokenLength(pending_.size() + i - token_begin);
+
+            std::string token = std::move(pending_);
+
+            pending_.clear();
+            token.append(data + token_begin, i - token_begin);
+            parser_.ParseToken(token);
+        } else if (i > token_begin) {
+            CheckTokenLength(i - token_begin);
+
+            parser_.ParseToken(std::string(data + token_begin, i - token_begin));
+        }
+
+        token_begin = i + 1;
+    }
+
+    CheckTokenLength(pending_.size() + size - token_begin);
+
+    pending_.append(data + token_begin, size - token_begin);
+}
+
+void ArgumentParser::StreamParser::Feed(const std::string& chunk) {
+    Feed(chunk.data(), chunk.size());
+}
+
+void ArgumentParser::StreamParser::Feed(std::istream& input, size_t chunk_size) {
+    std::vector<char> buffer(chunk_size);
+
+    while (input) {
+        input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        Feed(buffer.data(), static_cast<size_t>(input.gcount()));
+    }
+}
+
+bool ArgumentParser::StreamParser::Finish() {
+    if (!pending_.empty()) {
+        std::string token = std::move(pending_);
+
+        pending_.clear();
+        parser_.ParseToken(token);
+    }
+
+    return parser_.FinishParse();
+}
+
+bool ArgumentParser::StreamParser::IsSeparator(char symbol) const {
+    if (null_separated_) {
+        return symbol == '\0';
+    }
+
+    return symbol == ' ' || symbol == '\t' || symbol == '\n' || symbol == '\r' || symbol == '\0';
+}
+
+void ArgumentParser::StreamParser::CheckTokenLength(size_t length) {
+    size_t max_token_length = std::min(max_token_length_, parser_.GetLimits().max_token_length);
+
+    if (length > max_token_length) {
+        pending_.clear();
+        parser_.AbortParse();
+
+        throw std::runtime_error("Token is longer than " + std::to_string(max_token_length) + " bytes.");
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "ArgParser.h"
+
+#include <istream>
+#include <limits>
+#include <string>
+
+namespace ArgumentParser {
+    class StreamParser {
+    public:
+        StreamParser(ArgParser& parser, bool null_separated = false, size_t max_token_length = std::numeric_limits<size_t>::max());
+
+        void Feed(const char* data, size_t size);
+        void Feed(const std::string& chunk);
+        void Feed(std::istream& input, size_t chunk_size = 1 << 16);
+
+        bool Finish();
+    private:
+        ArgParser& parser_;
+
+        bool null_separated_;
+        size_t max_token_length_;
+
+        std::string pending_;
+
+        bool IsSeparator(char symbol) const;
+        void CheckTokenLength(size_t length);
+    };
+}
@@ -1,4 +1,6 @@
 #include <lib/ArgParser.h>
+#include <lib/Registry.h>
+#include <lib/StreamParser.h>
 #include <gtest/gtest.h>
 #include <sstream>
 
@@ -172,3 +174,513 @@ TEST(ArgParserTestSuite, HelpStringTest) {
         "-h, --help Display this help and exit\n"
     );
 }
+
+
+TEST(ArgParserTestSuite, StreamParserTest) {
+    ArgParser parser("My Parser");
+    std::vector<int> values;
+    parser.AddStringArgument("param1");
+    parser.AddIntArgument("Param2").MultiValue(1).Positional().StoreValues(values);
+
+    StreamParser stream(parser);
+    stream.Feed("--par");
+    stream.Feed("am1=val");
+    stream.Feed("ue1 1");
+    stream.Feed("2 3\n");
+    stream.Feed("4");
+
+    ASSERT_TRUE(stream.Finish());
+    ASSERT_EQ(parser.GetStringValue("param1"), "value1");
+    ASSERT_EQ(values.size(), 3);
+    ASSERT_EQ(values[0], 12);
+    ASSERT_EQ(values[2], 4);
+}
+
+
+TEST(ArgParserTestSuite, StreamParserTokenLengthTest) {
+    ArgParser parser("My Parser");
+    parser.AddStringArgument("param1");
+
+    StreamParser stream(parser, false, 8);
+    stream.Feed("--param");
+
+    ASSERT_THROW(stream.Feed("1=value1"), std::runtime_error);
+
+    ArgParser int_parser("My Parser");
+    int_parser.AddIntArgument("N").MultiValue().Positional();
+
+    StreamParser int_stream(int_parser);
+    int_stream.Feed("1 x");
+    ASSERT_THROW(int_stream.Feed("y 2 "), std::runtime_error);
+    int_stream.Feed("3");
+    ASSERT_TRUE(int_stream.Finish());
+    ASSERT_EQ(int_parser.GetIntValue("N", 0), 1);
+    ASSERT_EQ(int_parser.GetIntValue("N", 1), 3);
+
+    ArgParser long_parser("My Parser");
+    long_parser.AddStringArgument("param1");
+
+    StreamParser long_stream(long_parser);
+    long_stream.Feed("--param1=" + std::string(1 << 17, 'a'));
+    ASSERT_TRUE(long_stream.Finish());
+    ASSERT_EQ(long_parser.GetStringValue("param1").size(), 1 << 17);
+}
+
+
+TEST(ArgParserTestSuite, MultiplePositionalArgTest) {
+    ArgParser parser("My Parser");
+    std::vector<std::string> inputs;
+    std::vector<int> numbers;
+    std::string output;
+    parser.AddStringArgument("input").MultiValue().Positional().StoreValues(inputs);
+    parser.AddIntArgument("number").Positional(2).StoreValues(numbers);
+    parser.AddStringArgument("output").OptionalPositional().Default("out.txt").StoreValue(output);
+
+    ASSERT_TRUE(parser.Parse(SplitString("app a.txt b.txt c.txt 1 2")));
+    ASSERT_EQ(inputs, std::vector<std::string>({"a.txt", "b.txt", "c.txt"}));
+    ASSERT_EQ(numbers, std::vector<int>({1, 2}));
+    ASSERT_EQ(output, "out.txt");
+}
+
+
+TEST(ArgParserTestSuite, MissingPositionalArgTest) {
+    ArgParser parser("My Parser");
+    parser.AddStringArgument("input").OptionalPositional();
+    parser.AddIntArgument("number").Positional(2);
+
+    ASSERT_FALSE(parser.Parse(SplitString("app 1")));
+}
+
+
+TEST(ArgParserTestSuite, OptionalPositionalArgTest) {
+    ArgParser parser("My Parser");
+    std::string output = "unchanged";
+    parser.AddIntArgument("number").Positional(1);
+    parser.AddStringArgument("output").OptionalPositional().StoreValue(output);
+
+    ASSERT_TRUE(parser.Parse(SplitString("app 1")));
+    ASSERT_EQ(parser.GetIntValue("number"), 1);
+    ASSERT_EQ(parser.GetIntValues("number").Size(), 1);
+    ASSERT_EQ(output, "unchanged");
+
+    ASSERT_FALSE(parser.Parse(SplitString("app 1 out.txt extra.txt")));
+}
+
+
+TEST(ArgParserTestSuite, PositionalStorageMismatchTest) {
+    ArgParser parser("My Parser");
+    int value;
+
+    ASSERT_THROW(parser.AddIntArgument("first").Positional(2).StoreValue(value), std::runtime_error);
+    ASSERT_THROW(parser.AddIntArgument("second").StoreValue(value).Positional(2), std::runtime_error);
+    ASSERT_THROW(parser.AddIntArgument("third").StoreValue(value).MultiValue(), std::runtime_error);
+
+    ArgParser vector_parser("My Parser");
+    std::vector<int> numbers;
+    std::vector<std::string> names;
+    vector_parser.AddIntArgument("number").Positional(1).StoreValues(numbers);
+    vector_parser.AddStringArgument("name").OptionalPositional().StoreValues(names);
+
+    ASSERT_TRUE(vector_parser.Parse(SplitString("app 5")));
+    ASSERT_EQ(numbers, std::vector<int>({5}));
+    ASSERT_TRUE(names.empty());
+
+    ArgParser named_parser("My Parser");
+    named_parser.AddIntArgument("number").Positional(1).StoreValues(numbers);
+    named_parser.AddStringArgument("name").OptionalPositional().StoreValues(names);
+
+    ASSERT_TRUE(named_parser.Parse(SplitString("app 6 six")));
+    ASSERT_EQ(numbers, std::vector<int>({5, 6}));
+    ASSERT_EQ(names, std::vector<std::string>({"six"}));
+}
+
+
+TEST(ArgParserTestSuite, OptionHandleTest) {
+    ArgParser parser("My Parser");
+    parser.AddIntArgument('n', "number").MultiValue();
+    parser.AddStringArgument("name").Default("none");
+    parser.AddFlag('f', "flag1");
+
+    OptionHandle<int32_t> number = parser.GetHandle<int32_t>("number");
+    OptionHandle<std::string> name = parser.GetHandle<std::string>("name");
+    OptionHandle<bool> flag = parser.GetHandle<bool>("flag1");
+
+    ASSERT_THROW(parser.GetHandle<bool>("number"), std::runtime_error);
+
+    ASSERT_TRUE(parser.Parse(SplitString("app -n=1 --number=-7 -f")));
+    ASSERT_EQ(number.Size(), 2);
+    ASSERT_EQ(number.Get(1), -7);
+    ASSERT_EQ(name.Get(), "none");
+    ASSERT_TRUE(flag.Get());
+}
+
+
+TEST(ArgParserTestSuite, SignedIntTest) {
+    ArgParser parser("My Parser");
+    parser.AddIntArgument('n', "number").MultiValue();
+
+    ASSERT_TRUE(parser.Parse(SplitString("app --number=+5 -n=-5 -n=+0")));
+    ASSERT_EQ(parser.GetIntValue("number", 0), 5);
+    ASSERT_EQ(parser.GetIntValue("number", 1), -5);
+    ASSERT_EQ(parser.GetIntValue("number", 2), 0);
+
+    ASSERT_THROW(parser.Parse(SplitString("app --number=+-5")), std::runtime_error);
+    ASSERT_THROW(parser.Parse(SplitString("app --number=+")), std::runtime_error);
+}
+
+
+TEST(ArgParserTestSuite, StoreFieldsTest) {
+    struct Options {
+        std::string name;
+        int32_t number = 0;
+        bool verbose = false;
+        std::vector<int32_t> values;
+    };
+
+    Options options;
+    ArgParser parser("My Parser");
+    parser.AddStringArgument("name");
+    parser.AddIntArgument('n', "number");
+    parser.AddFlag('v', "verbose");
+    parser.AddIntArgument("values").MultiValue(1).Positional();
+    parser.StoreFields(
+        options,
+        Field("name", &Options::name),
+        Field("number", &Options::number),
+        Field("verbose", &Options::verbose),
+        Field("values", &Options::values)
+    );
+
+    ASSERT_TRUE(parser.Parse(SplitString("app --name=test -n=3 -v 1 2 3")));
+    ASSERT_EQ(options.name, "test");
+    ASSERT_EQ(options.number, 3);
+    ASSERT_TRUE(options.verbose);
+    ASSERT_EQ(options.values, std::vector<int32_t>({1, 2, 3}));
+}
+
+
+TEST(ArgParserTestSuite, IntRangeTest) {
+    ArgParser parser("My Parser");
+    std::vector<int> values;
+    parser.AddIntArgument('p', "param1").MultiValue().StoreValues(values);
+    parser.AddIntArgument("Param2").MultiValue(1).Positional();
+
+    ASSERT_TRUE(parser.Parse(SplitString("app -p=1..9:4 --param1=10..8 0 1..100000000 7")));
+    ASSERT_EQ(values, std::vector<int>({1, 5, 9, 10, 9, 8}));
+
+    const IntValues& positionals = parser.GetIntValues("Param2");
+    ASSERT_EQ(positionals.Size(), 100000002);
+    ASSERT_EQ(positionals[0], 0);
+    ASSERT_EQ(positionals[100000000], 100000000);
+    ASSERT_EQ(positionals[100000001], 7);
+    ASSERT_EQ(parser.GetIntValue("Param2", 5), 5);
+}
+
+
+TEST(ArgParserTestSuite, WrongIntRangeTest) {
+    ArgParser parser("My Parser");
+    parser.AddIntArgument("param1");
+    parser.AddIntArgument("param2").MultiValue();
+
+    ASSERT_THROW(parser.Parse(SplitString("app --param1=1..3")), std::runtime_error);
+    ASSERT_THROW(parser.Parse(SplitString("app --param2=1..3:-1")), std::runtime_error);
+}
+
+
+TEST(ArgParserTestSuite, MapTest) {
+    ArgParser parser("My Parser");
+    parser.AddMapArgument('D', "define");
+
+    ASSERT_TRUE(parser.Parse(SplitString("app -D=mode=fast --define=path=/a=b -D=empty= -D=mode=slow")));
+    ASSERT_EQ(parser.GetMap("define").Size(), 3);
+    ASSERT_EQ(parser.GetMapValue("define", "mode"), "slow");
+    ASSERT_EQ(parser.GetMapValue("define", "path"), "/a=b");
+    ASSERT_EQ(parser.GetMapValue("define", "empty"), "");
+    ASSERT_FALSE(parser.GetMap("define").Contains("missing"));
+    ASSERT_THROW(parser.GetMapValue("define", "missing"), std::runtime_error);
+}
+
+
+TEST(ArgParserTestSuite, MapDuplicatePolicyTest) {
+    ArgParser parser("My Parser");
+    parser.AddMapArgument('D', "define").DuplicateKeys(DuplicatePolicy::kKeepFirst);
+    parser.AddMapArgument('U', "unique").DuplicateKeys(DuplicatePolicy::kRejectDuplicates);
+
+    std::string args = "app";
+    for (int i = 0; i < 1000; ++i) {
+        args += " -D=key" + std::to_string(i) + "=" + std::to_string(i);
+    }
+
+    ASSERT_TRUE(parser.Parse(SplitString(args + " -D=key7=other")));
+    ASSERT_EQ(parser.GetMap("define").Size(), 1000);
+    ASSERT_EQ(parser.GetMapValue("define", "key7"), "7");
+    ASSERT_EQ(parser.GetMapValue("define", "key999"), "999");
+
+    ASSERT_THROW(parser.Parse(SplitString("app -U=a=1 -U=a=2")), std::runtime_error);
+}
+
+
+TEST(ArgParserTestSuite, MapCopyTest) {
+    ArgParser parser("My Parser");
+    parser.AddMapArgument('D', "define", "Some definitions");
+    parser.AddMapArgument('R', "require").MultiValue(1);
+    parser.AddHelp('h', "help", "Some Description about program");
+
+    ASSERT_TRUE(parser.Parse(SplitString("app -D=mode=fast -R=a=1")));
+
+    ArgParser copy = parser;
+    ASSERT_TRUE(parser.Parse(SplitString("app -D=mode=slow -R=b=2")));
+    ASSERT_EQ(copy.GetMapValue("define", "mode"), "fast");
+    ASSERT_EQ(copy.GetMapValue("require", "a"), "1");
+
+    copy = parser;
+    ASSERT_EQ(copy.GetMapValue("define", "mode"), "slow");
+    ASSERT_EQ(copy.GetMapValue("require", "b"), "2");
+
+    ASSERT_EQ(
+        parser.HelpDescription(),
+        "My Parser\n"
+        "Some Description about program\n"
+        "\n"
+        "-D,  --define=<key=value>,  Some definitions [optional]\n"
+        "-R,  --require=<key=value>,   [repeated, min entries = 1]\n"
+        "\n"
+        "-h, --help Display this help and exit\n"
+    );
+}
+
+
+TEST(ArgParserTestSuite, ParsedImageTest) {
+    ArgParser parser("My Parser");
+    parser.AddStringArgument('i', "input").MultiValue();
+    parser.AddIntArgument("number").MultiValue().Positional();
+    parser.AddFlag('v', "verbose");
+    parser.AddFlag('q', "quiet");
+    parser.AddMapArgument('D', "define");
+
+    ASSERT_TRUE(parser.Parse(SplitString("app -i=a.txt -i=b.txt -v -D=mode=fast -D=level=3 4 5 10..20:5 6")));
+
+    std::string image = parser.SerializeValues();
+    ParsedImage parsed(image.data(), image.size());
+
+    ASSERT_EQ(parsed.GetValuesCount("input"), 2);
+    ASSERT_EQ(parsed.GetStringValue("input", 1), "b.txt");
+    ASSERT_EQ(parsed.GetValuesCount("number"), 6);
+    ASSERT_EQ(parsed.GetIntValue("number", 1), 5);
+    ASSERT_EQ(parsed.GetIntValue("number", 3), 15);
+    ASSERT_EQ(parsed.GetIntValue("number", 5), 6);
+    ASSERT_TRUE(parsed.GetFlag("verbose"));
+    ASSERT_FALSE(parsed.GetFlag("quiet"));
+    ASSERT_EQ(parsed.GetMapValue("define", "level"), "3");
+    ASSERT_THROW(parsed.GetMapValue("define", "missing"), std::runtime_error);
+    ASSERT_THROW(parsed.GetIntValue("input"), std::runtime_error);
+    ASSERT_THROW(parsed.GetFlag("missing"), std::runtime_error);
+
+    std::string broken_slots = image;
+    broken_slots[20] = 3;
+    ASSERT_THROW(ParsedImage(broken_slots.data(), broken_slots.size()), std::runtime_error);
+
+    std::string broken_blob = image;
+    broken_blob[31] = 0x7F;
+    ASSERT_THROW(ParsedImage(broken_blob.data(), broken_blob.size()), std::runtime_error);
+
+    image[image.size() - 1] ^= 1;
+    ASSERT_THROW(ParsedImage(image.data(), image.size()), std::runtime_error);
+}
+
+
+TEST(ArgParserTestSuite, DefaultReplacedTest) {
+    ArgParser parser("My Parser");
+    parser.AddStringArgument("param1").Default("value1");
+    parser.AddIntArgument("param2").MultiValue().Default(7);
+
+    ASSERT_TRUE(parser.Parse(SplitString("app --param1=value2 --param2=1 --param2=2")));
+    ASSERT_EQ(parser.GetStringValue("param1"), "value2");
+    ASSERT_EQ(parser.GetIntValues("param2").Size(), 2);
+    ASSERT_EQ(parser.GetIntValue("param2"), 1);
+}
+
+
+TEST(ArgParserTestSuite, PositionalAfterOptionTest) {
+    ArgParser routed("My Parser");
+    routed.AddIntArgument("N").MultiValue(1).Positional().Default(7);
+
+    ASSERT_TRUE(routed.Parse(SplitString("app --N=5 1 2")));
+    ASSERT_EQ(routed.GetIntValues("N").Size(), 3);
+    ASSERT_EQ(routed.GetIntValue("N", 0), 5);
+    ASSERT_EQ(routed.GetIntValue("N", 2), 2);
+
+    ArgParser reordered("My Parser");
+    reordered.AddIntArgument("N").MultiValue(1).Positional().Default(7);
+
+    ASSERT_TRUE(reordered.Parse(SplitString("app 1 2 --N=5")));
+    ASSERT_EQ(reordered.GetIntValues("N").Size(), 3);
+    ASSERT_EQ(reordered.GetIntValue("N", 2), 5);
+
+    ArgParser buffered("My Parser");
+    buffered.AddIntArgument("N").MultiValue(1).Positional().Default(7);
+    buffered.AddStringArgument("output").Positional(1);
+
+    ASSERT_TRUE(buffered.Parse(SplitString("app --N=5 1 2 out.txt")));
+    ASSERT_EQ(buffered.GetIntValues("N").Size(), 3);
+    ASSERT_EQ(buffered.GetIntValue("N", 0), 5);
+    ASSERT_EQ(buffered.GetStringValue("output"), "out.txt");
+}
+
+
+TEST(ArgParserTestSuite, SinkTest) {
+    ArgParser parser("My Parser");
+    std::vector<size_t> batches;
+    int64_t sum = 0;
+    parser.AddIntArgument("N").MultiValue(1).Positional().Sink([&](const IntValues& values) {
+        batches.push_back(values.Size());
+
+        for (int32_t value: values) {
+            sum += value;
+        }
+    }, 2);
+
+    parser.ParseToken("1");
+    parser.ParseToken("2");
+    ASSERT_EQ(batches, std::vector<size_t>({2}));
+
+    parser.ParseToken("3");
+    parser.ParseToken("10..13");
+    parser.ParseToken("--N=4");
+    ASSERT_EQ(batches, std::vector<size_t>({2, 5}));
+
+    ASSERT_TRUE(parser.FinishParse());
+    ASSERT_EQ(batches, std::vector<size_t>({2, 5, 1}));
+    ASSERT_EQ(sum, 1 + 2 + 3 + 10 + 11 + 12 + 13 + 4);
+    ASSERT_EQ(parser.GetIntValues("N").Size(), 0);
+    ASSERT_EQ(parser.GetHandle<int32_t>("N").Size(), 0);
+    ASSERT_EQ(parser.GetStats().max_values_per_argument, 8);
+
+    std::string image = parser.SerializeValues();
+    ASSERT_EQ(ParsedImage(image.data(), image.size()).GetValuesCount("N"), 0);
+
+    std::vector<int> values;
+    ASSERT_THROW(parser.AddIntArgument("M").Sink([](const IntValues&) {}).StoreValues(values), std::runtime_error);
+}
+
+
+TEST(ArgParserTestSuite, ParseLimitsTest) {
+    ParseLimits limits;
+    limits.max_tokens = 4;
+    limits.max_values_per_argument = 2;
+    limits.max_token_length = 16;
+    limits.max_value_bytes = 12;
+
+    ArgParser parser("My Parser");
+    parser.SetLimits(limits);
+    parser.AddStringArgument('s', "string").MultiValue();
+    parser.AddIntArgument('n', "number").MultiValue();
+
+    ASSERT_TRUE(parser.Parse(SplitString("app -s=abc -n=1..2 -s=de")));
+    ASSERT_EQ(parser.GetStats().tokens, 3);
+    ASSERT_EQ(parser.GetStats().value_bytes, 9);
+    ASSERT_EQ(parser.GetStats().max_values_per_argument, 2);
+    ASSERT_EQ(parser.GetStats().max_token_length, 7);
+
+    ASSERT_TRUE(parser.Parse(SplitString("app")));
+    ASSERT_EQ(parser.GetStats().tokens, 0);
+    ASSERT_EQ(parser.GetStats().value_bytes, 0);
+    ASSERT_EQ(parser.GetStats().max_token_length, 0);
+
+    ArgParser tokens_parser("My Parser");
+    tokens_parser.SetLimits(limits);
+    tokens_parser.AddIntArgument('n', "number").MultiValue();
+    ASSERT_THROW(tokens_parser.Parse(SplitString("app -n=1 -n=2 -n=3 -n=4 -n=5")), std::runtime_error);
+
+    ArgParser values_parser("My Parser");
+    values_parser.SetLimits(limits);
+    values_parser.AddIntArgument('n', "number").MultiValue();
+    ASSERT_THROW(values_parser.Parse(SplitString("app -n=1..3")), std::runtime_error);
+
+    ArgParser length_parser("My Parser");
+    length_parser.SetLimits(limits);
+    length_parser.AddStringArgument('s', "string");
+    ASSERT_THROW(length_parser.Parse(SplitString("app --string=very-long-value")), std::runtime_error);
+
+    ArgParser bytes_parser("My Parser");
+    bytes_parser.SetLimits(limits);
+    bytes_parser.AddStringArgument('s', "string").MultiValue();
+    ASSERT_THROW(bytes_parser.Parse(SplitString("app -s=abcdefg -s=abcdefg")), std::runtime_error);
+    ASSERT_TRUE(bytes_parser.Parse(SplitString("app -s=abc")));
+    ASSERT_EQ(bytes_parser.GetStats().tokens, 1);
+    ASSERT_EQ(bytes_parser.GetStats().value_bytes, 3);
+
+    ArgParser stream_parser("My Parser");
+    stream_parser.SetLimits(limits);
+    stream_parser.AddStringArgument('s', "string").MultiValue();
+    stream_parser.AddIntArgument("number").MultiValue().Positional();
+    StreamParser stream(stream_parser);
+    stream.Feed("-s=abc 1 ");
+    ASSERT_THROW(stream.Feed("-s=very-long-value "), std::runtime_error);
+    ASSERT_TRUE(stream_parser.Parse(SplitString("app 2")));
+    ASSERT_EQ(stream_parser.GetStats().tokens, 1);
+}
+
+
+TEST(ArgParserTestSuite, DelimiterTest) {
+    ArgParser parser("My Parser");
+    std::vector<int> ids;
+    parser.AddIntArgument("ids").MultiValue().Delimiter(',').StoreValues(ids);
+    parser.AddStringArgument('t', "tags").MultiValue().Delimiter(':');
+    parser.AddMapArgument('D', "define").Delimiter(',');
+
+    ASSERT_TRUE(parser.Parse(SplitString("app --ids=1,2,10..30:10 --ids=7 -t=a::b -D=x=1,y=2")));
+    ASSERT_EQ(ids, std::vector<int>({1, 2, 10, 20, 30, 7}));
+    ASSERT_EQ(parser.GetStringValue("tags", 0), "a");
+    ASSERT_EQ(parser.GetStringValue("tags", 1), "");
+    ASSERT_EQ(parser.GetStringValue("tags", 2), "b");
+    ASSERT_EQ(parser.GetMapValue("define", "y"), "2");
+
+    ArgParser wrong_parser("My Parser");
+    wrong_parser.AddIntArgument("ids").MultiValue().Delimiter(',');
+    ASSERT_THROW(wrong_parser.Parse(SplitString("app --ids=1,,2")), std::runtime_error);
+
+    ArgParser single_parser("My Parser");
+    single_parser.AddStringArgument("name").Delimiter(',');
+    ASSERT_TRUE(single_parser.Parse(SplitString("app --name=abc")));
+    ASSERT_EQ(single_parser.GetStringValue("name"), "abc");
+    ASSERT_THROW(single_parser.Parse(SplitString("app --name=a,b")), std::runtime_error);
+
+    ParseLimits limits;
+    limits.max_values_per_argument = 2;
+    int count = 0;
+    ArgParser limited_parser("My Parser");
+    limited_parser.SetLimits(limits);
+    limited_parser.AddIntArgument("ids").MultiValue().Delimiter(',').Sink([&count](const IntValues& values) { count += values.Size(); }, 1);
+    ASSERT_THROW(limited_parser.Parse(SplitString("app --ids=1,2,3,4,5")), std::runtime_error);
+    ASSERT_EQ(count, 3);
+}
+
+
+ARGPARSER_REGISTER_OPTION(ArgumentType::kInteger, 'w', "workers", "Worker count", [](Argument& arg) { arg.Default(4); });
+ARGPARSER_REGISTER_OPTION(ArgumentType::kFlag, 'r', "registry-verbose", "Verbose registry");
+ARGPARSER_REGISTER_OPTION(ArgumentType::kString, "registry-name");
+
+
+TEST(ArgParserTestSuite, RegisteredOptionsTest) {
+    ArgParser parser("My Parser");
+    parser.AddRegisteredOptions();
+
+    ASSERT_TRUE(parser.Parse(SplitString("app --registry-verbose --registry-name=test")));
+    ASSERT_EQ(parser.GetIntValue("workers"), 4);
+    ASSERT_TRUE(parser.GetFlag("registry-verbose"));
+    ASSERT_EQ(parser.GetStringValue("registry-name"), "test");
+}
+
+
+TEST(ArgParserTestSuite, RegisteredOptionsCollisionTest) {
+    ArgParser parser("My Parser");
+    parser.AddFlag('w', "wide");
+
+    ASSERT_THROW(parser.AddRegisteredOptions(), std::runtime_error);
+    ASSERT_THROW(parser.GetIntValue("workers"), std::runtime_error);
+    ASSERT_THROW(parser.GetFlag("registry-verbose"), std::runtime_error);
+
+    ASSERT_TRUE(parser.Parse(SplitString("app -w")));
+    ASSERT_TRUE(parser.GetFlag("wide"));
+}